@@ -183,7 +183,7 @@ class AdvectionSolverImplicit :
   void MakeIteration() override {
     auto& prev = fc_u_.iter_prev;
     auto& curr = fc_u_.iter_curr;
-    prev = curr;
+    fc_u_.RotateIter();
 
     ff_volume_flux_ = ConvertVolumeFlux(this->p_f_velocity_);
 
@@ -245,8 +245,7 @@ class AdvectionSolverImplicit :
     this->IncIterationCount();
   }
   void FinishStep() override {
-    fc_u_.time_prev = fc_u_.time_curr;
-    fc_u_.time_curr = fc_u_.iter_curr;
+    fc_u_.RotateTime();
     this->IncTime();
   }
   double GetConvergenceIndicator() const {
@@ -321,14 +320,18 @@ class AdvectionSolverExplicit :
   void MakeIteration() override {
     auto& prev = fc_u_.iter_prev;
     auto& curr = fc_u_.iter_curr;
-    prev = curr;
+    fc_u_.RotateIter();
 
     ff_volume_flux_ = ConvertVolumeFlux(this->p_f_velocity_);
 
-    ff_u_ = InterpolateSuperbee(
-        prev,
-        Gradient(Interpolate(prev, mf_u_cond_, mesh), mesh),
-        mf_u_cond_, ff_volume_flux_, mesh);
+    {
+      geom::FieldFaceBuffer<Scal> ff(mesh);
+      geom::FieldCellBuffer<Vect> fc_grad(mesh);
+      Interpolate(prev, mf_u_cond_, mesh, *ff);
+      Gradient(*ff, mesh, *fc_grad);
+      InterpolateSuperbee(
+          prev, *fc_grad, mf_u_cond_, ff_volume_flux_, mesh, ff_u_);
+    }
 
     for (auto idxface : mesh.Faces()) {
       ff_flux_[idxface] = ff_u_[idxface] * ff_volume_flux_[idxface];
@@ -377,6 +380,7 @@ class AdvectionSolverMultiExplicit :
   using IdxCell = geom::IdxCell;
   using IdxFace = geom::IdxFace;
   using IdxNode = geom::IdxNode;
+  using Direction = geom::Direction<dim>;
   using Expr = Expression<Scal, IdxCell, 1 + dim * 2>;
   std::vector<geom::MapFace<std::shared_ptr<ConditionFace>>> v_mf_u_cond_;
   std::vector<const VelocityField*> v_p_ff_volume_flux_slip_;
@@ -407,7 +411,9 @@ class AdvectionSolverMultiExplicit :
       , sharp_(sharp)
       , sharp_max_(sharp_max)
   {
-    v_fc_u_.resize(num_fields_);
+    // Fields are updated in place from the start of the step
+    v_fc_u_.resize(num_fields_, LayersData<geom::FieldCell<Scal>>(
+        {Layers::time_curr, Layers::iter_curr}));
     v_mf_u_cond_.resize(num_fields_);
     for (size_t field = 0; field < num_fields_; ++field) {
       v_fc_u_[field].time_curr = v_fc_u_initial[field];
@@ -417,8 +423,7 @@ class AdvectionSolverMultiExplicit :
   void StartStep() override {
     this->ClearIterationCount();
     for (size_t field = 0; field < num_fields_; ++field) {
-      v_fc_u_[field].time_prev = v_fc_u_[field].time_curr;
-      v_fc_u_[field].iter_curr = v_fc_u_[field].time_prev;
+      v_fc_u_[field].iter_curr = v_fc_u_[field].time_curr;
     }
   }
   // Correct the inconsistency with arguments: velocity vs volume flux
@@ -442,9 +447,7 @@ class AdvectionSolverMultiExplicit :
         ConvertVolumeFlux(this->p_f_velocity_);
 
     for (size_t field = 0; field < num_fields_; ++field) {
-      auto& prev = v_fc_u_[field].iter_prev;
       auto& curr = v_fc_u_[field].iter_curr;
-      prev = curr;
 
       const auto& ff_volume_flux_slip =
           ConvertVolumeFlux(v_p_ff_volume_flux_slip_[field]);
@@ -456,13 +459,39 @@ class AdvectionSolverMultiExplicit :
       // Apply operator in each direction
       size_t num_stages = (spatial_split_ ? dim : 1);
       for (size_t stage = 0; stage < num_stages; ++stage) {
-        ff_u_ = InterpolateSuperbee(
-            curr,
-            Gradient(Interpolate(curr, v_mf_u_cond_[field], mesh), mesh),
-            v_mf_u_cond_[field], ff_volume_flux, mesh);
+        {
+          geom::FieldFaceBuffer<Scal> ff(mesh);
+          geom::FieldCellBuffer<Vect> fc_grad(mesh);
+          Interpolate(curr, v_mf_u_cond_[field], mesh, *ff);
+          Gradient(*ff, mesh, *fc_grad);
+          InterpolateSuperbee(curr, *fc_grad, v_mf_u_cond_[field],
+                              ff_volume_flux, mesh, ff_u_);
+        }
 
 //        ff_u_ = solver::InterpolateFirstUpwind(
 //            curr, v_mf_u_cond_[field], ff_volume_flux, mesh);
+        if (spatial_split_ && !geom::IsTile(mesh.GetBlockCells().GetTile())) {
+          // Stream along grid lines in direction of the stage
+          Direction dir(stage);
+          auto cell_lines = mesh.GetBlockCells().GetLines(dir);
+          auto face_lines = mesh.GetBlockFaces().GetLines(dir);
+#pragma omp parallel for
+          for (IntIdx l = 0; l < IntIdx(cell_lines.size()); ++l) {
+            const auto& cells = cell_lines[l];
+            const auto& faces = face_lines[l];
+            for (size_t j = 0; j < cells.size(); ++j) {
+              IdxCell idxcell = cells[j];
+              IdxFace fm = faces[j];
+              IdxFace fp = faces[j + 1];
+              Scal flux_sum = 0.;
+              flux_sum += ff_u_[fm] * ff_volume_flux[fm] * (-1.);
+              flux_sum += ff_u_[fp] * ff_volume_flux[fp];
+              curr[idxcell] +=
+                  -this->GetTimeStep() / mesh.GetVolume(idxcell) * flux_sum;
+            }
+          }
+          continue;
+        }
         for (auto idxcell : mesh.Cells()) {
           Scal flux_sum = 0.;
           for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
@@ -481,11 +510,9 @@ class AdvectionSolverMultiExplicit :
       // Interface sharpening
       // zero-derivative bc for Vect
       geom::MapFace<std::shared_ptr<ConditionFace>> mfvz;
-      for (auto idxface : mesh.Faces()) {
-        if (!mesh.IsExcluded(idxface) && !mesh.IsInner(idxface)) {
-          mfvz[idxface] =
-              std::make_shared<ConditionFaceDerivativeFixed<Vect>>(Vect(0));
-        }
+      for (auto idxface : mesh.BoundaryFaces()) {
+        mfvz[idxface] =
+            std::make_shared<ConditionFaceDerivativeFixed<Vect>>(Vect(0));
       }
       auto af = Interpolate(curr, v_mf_u_cond_[field], mesh);
       auto gc = Gradient(af, mesh);
@@ -539,7 +566,7 @@ class AdvectionSolverMultiExplicit :
   }
   void FinishStep() override {
     for (size_t field = 0; field < num_fields_; ++field) {
-      v_fc_u_[field].time_curr = v_fc_u_[field].iter_curr;
+      v_fc_u_[field].RotateTime();
     }
     this->IncTime();
   }
@@ -703,7 +730,11 @@ class AdvectionSolverMultiParticles :
       for (size_t i = 0; i < mesh.GetNumNeighbourNodes(idxface); ++i) {
         auto idxnode = mesh.GetNeighbourNode(idxface, i);
         auto dir = mesh.GetDirection(idxface);
-        res[idxnode][dir] += (*p_f_velocity)[idxface] / mesh.GetArea(idxface);
+        // Faces of zero area (e.g. on the axis) have zero velocity
+        Scal area = mesh.GetArea(idxface);
+        if (area != 0.) {
+          res[idxnode][dir] += (*p_f_velocity)[idxface] / area;
+        }
         denominator[idxnode][dir] += 1.;
       }
     }
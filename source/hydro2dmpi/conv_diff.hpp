@@ -11,6 +11,7 @@
 #include "linear.hpp"
 #include <exception>
 #include "solver.hpp"
+#include "ghost.hpp"
 #include "../control/metrics.hpp"
 #include <cmath>
 #include <sstream>
@@ -67,18 +68,40 @@ class ConvectionDiffusionScalarImplicit :
   using Expr = Expression<Scal, IdxCell, 1 + dim * 2>;
 
   geom::MapFace<std::shared_ptr<ConditionFace>> mf_cond_;
+  ConditionFaceTable<Scal, Mesh> mf_cond_table_;
   geom::MapCell<std::shared_ptr<ConditionCell>> mc_cond_;
   std::shared_ptr<LinearSolver<Scal, IdxCell, Expr>> linear_;
+  CompactNumbering<IdxCell> active_; // cells not excluded
   Scal relaxation_factor_;
   bool time_second_order_;
   Scal guess_extrapolation_;
+  // Lagged operator: coefficients assembled at some iteration
+  // are reused for at most reuse_limit_ following iterations
+  // while the volume flux differs by less than reuse_flux_threshold_
+  // and scaling and diffusion rate are unchanged.
+  // The constant part is recomputed at every iteration.
+  size_t reuse_limit_;
+  Scal reuse_flux_threshold_;
+  size_t reuse_count_;
+  bool is_operator_valid_;
+  geom::FieldCell<Expr> fc_operator_; // without source and under-relaxation
+  geom::FieldFace<Scal> ff_vol_flux_assembled_;
+  geom::FieldCell<Scal> fc_scaling_assembled_;
+  geom::FieldFace<Scal> ff_diffusion_rate_assembled_;
+  // Implicit linear sink: adds coefficient to the diagonal, nullptr if none
+  const geom::FieldCell<Scal>* p_fc_sink_;
 
   // Common buffers:
   geom::FieldFace<Expr> ff_cflux_;
   geom::FieldFace<Expr> ff_dflux_;
+  geom::FieldFace<Scal> ff_cflux_const_;
+  geom::FieldFace<Scal> ff_dflux_const_;
   geom::FieldCell<Expr> fc_system_;
   geom::FieldCell<Scal> fc_corr_;
   geom::FieldCell<Vect> fc_grad_;
+  // Ghost cells for the gradient, empty if not applicable
+  FieldCellGhost<Scal, dim> fg_prev_;
+  bool use_ghost_;
 
  public:
   ConvectionDiffusionScalarImplicit(
@@ -98,7 +121,10 @@ class ConvectionDiffusionScalarImplicit :
       double convergence_tolerance,
       size_t num_iterations_limit,
       bool time_second_order = true,
-      Scal guess_extrapolation = 0.)
+      Scal guess_extrapolation = 0.,
+      size_t reuse_limit = 0,
+      Scal reuse_flux_threshold = 0.,
+      const geom::FieldCell<Scal>* p_fc_sink = nullptr)
       : ConvectionDiffusionScalar<Mesh>(
           time, time_step, p_fc_scaling, p_ff_diffusion_rate, p_fc_source,
           p_ff_vol_flux,
@@ -109,11 +135,51 @@ class ConvectionDiffusionScalarImplicit :
       , relaxation_factor_(relaxation_factor)
       , time_second_order_(time_second_order)
       , guess_extrapolation_(guess_extrapolation)
+      , reuse_limit_(reuse_limit)
+      , reuse_flux_threshold_(reuse_flux_threshold)
+      , reuse_count_(0)
+      , is_operator_valid_(false)
+      , p_fc_sink_(p_fc_sink)
   {
     fc_field_.time_curr = fc_initial;
     fc_field_.time_prev = fc_field_.time_curr;
 
     linear_ = linear_factory.Create<Scal, IdxCell, Expr>();
+    active_ = CompactNumbering<IdxCell>(mesh.Cells().size(),
+                                        mesh.ActiveCells());
+
+    for (auto idxface : mesh.BoundaryFaces()) {
+      if (!mf_cond_.find(idxface)) {
+        throw std::runtime_error("Boundary condition not set");
+      }
+    }
+    mf_cond_table_.Compile(mf_cond_, mesh);
+    if (!mf_cond_table_.GetExtrapolations().empty()) {
+      throw std::runtime_error("Unknown boundary condition type");
+    }
+
+    // Ghost cells need lexicographic numbering and no excluded cells
+    use_ghost_ = !geom::IsTile(mesh.GetBlockCells().GetTile());
+    for (auto idxcell : mesh.Cells()) {
+      if (mesh.IsExcluded(idxcell)) {
+        use_ghost_ = false;
+        break;
+      }
+    }
+    if (use_ghost_) {
+      fg_prev_ = FieldCellGhost<Scal, dim>(mesh.GetBlockCells(), 1);
+    }
+
+    // Rows of excluded cells are identities, only active rows
+    // are assembled and solved
+    fc_system_.Reinit(mesh);
+    for (auto idxcell : mesh.Cells()) {
+      if (mesh.IsExcluded(idxcell)) {
+        Expr& eqn = fc_system_[idxcell];
+        eqn.InsertTerm(1., idxcell);
+        eqn.SetConstant(0.);
+      }
+    }
   }
   void StartStep() override {
     this->ClearIterationCount();
@@ -126,67 +192,109 @@ class ConvectionDiffusionScalarImplicit :
           (fc_field_.time_curr[idxcell] - fc_field_.time_prev[idxcell]) *
           guess_extrapolation_;
     }
+    // Time layers (and possibly time step) have changed
+    is_operator_valid_ = false;
   }
-  void MakeIteration() override {
-    auto& fc_prev = fc_field_.iter_prev;
-    auto& fc_curr = fc_field_.iter_curr;
-    fc_prev = fc_curr;
-
-    fc_grad_ = Gradient(Interpolate(fc_prev, mf_cond_, mesh), mesh);
+  // Returns true if the operator from the previous assembly
+  // may be used for the current iteration
+  bool IsOperatorReusable() const {
+    if (!is_operator_valid_ || reuse_count_ >= reuse_limit_) {
+      return false;
+    }
+    const auto& ff_vol_flux = *this->p_ff_vol_flux_;
+    const auto& ff_diffusion_rate = *this->p_ff_diffusion_rate_;
+    for (auto idxface : mesh.Faces()) {
+      if (std::abs(ff_vol_flux[idxface] - ff_vol_flux_assembled_[idxface]) >
+          reuse_flux_threshold_ ||
+          ff_diffusion_rate[idxface] !=
+          ff_diffusion_rate_assembled_[idxface]) {
+        return false;
+      }
+    }
+    const auto& fc_scaling = *this->p_fc_scaling_;
+    for (auto idxcell : mesh.Cells()) {
+      if (fc_scaling[idxcell] != fc_scaling_assembled_[idxcell]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Gradient of fc_prev for deferred correction
+  void CalcGradient(const geom::FieldCell<Scal>& fc_prev) {
+    if (use_ghost_) {
+      FillGhost(fg_prev_, fc_prev, mf_cond_table_, mesh);
+      GradientGhost(fg_prev_, mesh, fc_grad_);
+    } else {
+      geom::FieldFaceBuffer<Scal> ff(mesh);
+      Interpolate(fc_prev, mf_cond_table_, mesh, *ff);
+      Gradient(*ff, mesh, fc_grad_);
+    }
+  }
+  // Assembles fc_operator_ using the current volume flux
+  // and fc_prev for deferred correction
+  void AssembleOperator(const geom::FieldCell<Scal>& fc_prev) {
+    // Values of conditions may have changed since the last assembly
+    mf_cond_table_.Update();
+    CalcGradient(fc_prev);
 
     InterpolationInnerFaceSecondUpwindDeferred<Mesh, Expr>
     value_inner(mesh, *this->p_ff_vol_flux_, fc_prev, fc_grad_);
 
-    InterpolationBoundaryFaceNearestCell<Mesh, Expr>
-    value_boundary(mesh, mf_cond_);
-
     DerivativeInnerFacePlain<Mesh, Expr>
     derivative_inner(mesh);
 
-    DerivativeBoundaryFacePlain<Mesh, Expr>
-    derivative_boundary(mesh, mf_cond_);
+    const auto& ff_vol_flux = *this->p_ff_vol_flux_;
+    const auto& ff_diffusion_rate = *this->p_ff_diffusion_rate_;
 
-    // Compute convective fluxes
+    // Compute convective and diffusive fluxes on inner faces
     ff_cflux_.Reinit(mesh, Expr());
-#pragma omp parallel for
-    for (IntIdx i = 0; i < static_cast<IntIdx>(mesh.Faces().size()); ++i) {
-      IdxFace idxface(i);
-      if (!mesh.IsExcluded(idxface)) {
-        Expr value_expr, derivative_expr;
-        if (mesh.IsInner(idxface)) {
-          value_expr = value_inner.GetExpression(idxface);
-        } else {
-          value_expr = value_boundary.GetExpression(idxface);
-        }
+    ff_dflux_.Reinit(mesh, Expr());
+#pragma omp parallel
+    for (auto& run : mesh.InnerFaces().GetRuns()) {
+#pragma omp for nowait
+      for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+        IdxFace idxface(i);
         ff_cflux_[idxface] =
-            value_expr * (*this->p_ff_vol_flux_)[idxface];
+            value_inner.GetExpression(idxface) * ff_vol_flux[idxface];
+        ff_dflux_[idxface] = derivative_inner.GetExpression(idxface) *
+            (-ff_diffusion_rate[idxface]) * mesh.GetArea(idxface);
       }
     }
 
-    // Compute diffusive fluxes
-    ff_dflux_.Reinit(mesh, Expr());
-#pragma omp parallel for
-    for (IntIdx i = 0; i < static_cast<IntIdx>(mesh.Faces().size()); ++i) {
-      IdxFace idxface(i);
-      if (!mesh.IsExcluded(idxface)) {
-        Expr value_expr, derivative_expr;
-        if (mesh.IsInner(idxface)) {
-          derivative_expr = derivative_inner.GetExpression(idxface);
-        } else {
-          derivative_expr = derivative_boundary.GetExpression(idxface);
-        }
-        ff_dflux_[idxface] = derivative_expr *
-            (-(*this->p_ff_diffusion_rate_)[idxface]) * mesh.GetArea(idxface);
-      }
+    // Boundary faces with given value
+    for (auto& e : mf_cond_table_.GetValues()) {
+      IdxFace idxface = e.idxface;
+      Expr value;
+      value.SetConstant(e.value);
+      Scal alpha = 1. / e.dist * e.factor;
+      Expr derivative;
+      derivative.SetConstant(alpha * e.value);
+      derivative.InsertTerm(-alpha, e.idxcell);
+      ff_cflux_[idxface] = value * ff_vol_flux[idxface];
+      ff_dflux_[idxface] = derivative *
+          (-ff_diffusion_rate[idxface]) * mesh.GetArea(idxface);
+    }
+    // Boundary faces with given derivative
+    for (auto& e : mf_cond_table_.GetDerivatives()) {
+      IdxFace idxface = e.idxface;
+      Scal alpha = e.dist * e.factor;
+      Expr value;
+      value.SetConstant(alpha * e.derivative);
+      value.InsertTerm(1., e.idxcell);
+      Expr derivative;
+      derivative.SetConstant(e.derivative);
+      ff_cflux_[idxface] = value * ff_vol_flux[idxface];
+      ff_dflux_[idxface] = derivative *
+          (-ff_diffusion_rate[idxface]) * mesh.GetArea(idxface);
     }
 
-    // Assemble the system
-    fc_system_.Reinit(mesh);
-#pragma omp parallel for
-    for (IntIdx i = 0; i < static_cast<IntIdx>(mesh.Cells().size()); ++i) {
-      IdxCell idxcell(i);
-      Expr& eqn = fc_system_[idxcell];
-      if (!mesh.IsExcluded(idxcell)) {
+    // Assemble the operator
+    fc_operator_.Reinit(mesh);
+#pragma omp parallel
+    for (auto& run : mesh.ActiveCells().GetRuns()) {
+#pragma omp for nowait
+      for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+        IdxCell idxcell(i);
         Expr cflux_sum;
         for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
           IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
@@ -209,20 +317,122 @@ class ConvectionDiffusionScalarImplicit :
             coeffs[0] * fc_field_.time_prev[idxcell] +
             coeffs[1] * fc_field_.time_curr[idxcell]);
 
-        eqn = (unsteady + cflux_sum / mesh.GetVolume(idxcell)) *
-              ((*this->p_fc_scaling_)[idxcell]) +
-              dflux_sum / mesh.GetVolume(idxcell) -
-              Expr((*this->p_fc_source_)[idxcell]);
+        fc_operator_[idxcell] =
+            (unsteady + cflux_sum / mesh.GetVolume(idxcell)) *
+            ((*this->p_fc_scaling_)[idxcell]) +
+            dflux_sum / mesh.GetVolume(idxcell);
+      }
+    }
+
+    if (reuse_limit_ > 0) {
+      ff_vol_flux_assembled_ = *this->p_ff_vol_flux_;
+      fc_scaling_assembled_ = *this->p_fc_scaling_;
+      ff_diffusion_rate_assembled_ = *this->p_ff_diffusion_rate_;
+    }
+    reuse_count_ = 0;
+    is_operator_valid_ = true;
+  }
+  // Recomputes the constant part of fc_operator_ (boundary values,
+  // deferred correction, previous time layers) keeping the coefficients.
+  // Uses the volume flux from the last assembly, so the result
+  // coincides with AssembleOperator() if the flux is unchanged.
+  void AssembleConstant(const geom::FieldCell<Scal>& fc_prev) {
+    mf_cond_table_.Update();
+    CalcGradient(fc_prev);
+
+    const auto& ff_vol_flux = ff_vol_flux_assembled_;
+    const auto& ff_diffusion_rate = *this->p_ff_diffusion_rate_;
+
+    InterpolationInnerFaceSecondUpwindDeferred<Mesh, Expr>
+    value_inner(mesh, ff_vol_flux, fc_prev, fc_grad_);
+
+    // Deferred correction on inner faces
+    ff_cflux_const_.Reinit(mesh, 0.);
+    ff_dflux_const_.Reinit(mesh, 0.);
+#pragma omp parallel
+    for (auto& run : mesh.InnerFaces().GetRuns()) {
+#pragma omp for nowait
+      for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+        IdxFace idxface(i);
+        ff_cflux_const_[idxface] =
+            value_inner.GetExpression(idxface).GetConstant() *
+            ff_vol_flux[idxface];
+      }
+    }
+
+    // Boundary faces with given value
+    for (auto& e : mf_cond_table_.GetValues()) {
+      IdxFace idxface = e.idxface;
+      Scal alpha = 1. / e.dist * e.factor;
+      ff_cflux_const_[idxface] = e.value * ff_vol_flux[idxface];
+      ff_dflux_const_[idxface] = alpha * e.value *
+          (-ff_diffusion_rate[idxface]) * mesh.GetArea(idxface);
+    }
+    // Boundary faces with given derivative
+    for (auto& e : mf_cond_table_.GetDerivatives()) {
+      IdxFace idxface = e.idxface;
+      Scal alpha = e.dist * e.factor;
+      ff_cflux_const_[idxface] = alpha * e.derivative * ff_vol_flux[idxface];
+      ff_dflux_const_[idxface] = e.derivative *
+          (-ff_diffusion_rate[idxface]) * mesh.GetArea(idxface);
+    }
+
+    auto dt = this->GetTimeStep();
+    auto coeffs = GetDerivativeApproxCoeffs(
+        0., {-2. * dt, -dt, 0.}, time_second_order_ ? 0 : 1);
+
+#pragma omp parallel
+    for (auto& run : mesh.ActiveCells().GetRuns()) {
+#pragma omp for nowait
+      for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+        IdxCell idxcell(i);
+        Scal cflux_sum = 0.;
+        Scal dflux_sum = 0.;
+        for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
+          IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
+          Scal factor = mesh.GetOutwardFactor(idxcell, i);
+          cflux_sum += ff_cflux_const_[idxface] * factor;
+          dflux_sum += ff_dflux_const_[idxface] * factor;
+        }
+        Scal unsteady =
+            coeffs[0] * fc_field_.time_prev[idxcell] +
+            coeffs[1] * fc_field_.time_curr[idxcell];
+        fc_operator_[idxcell].SetConstant(
+            (unsteady + cflux_sum / mesh.GetVolume(idxcell)) *
+            ((*this->p_fc_scaling_)[idxcell]) +
+            dflux_sum / mesh.GetVolume(idxcell));
+      }
+    }
+  }
+  void MakeIteration() override {
+    auto& fc_prev = fc_field_.iter_prev;
+    auto& fc_curr = fc_field_.iter_curr;
+    fc_field_.RotateIter();
+
+    if (IsOperatorReusable()) {
+      AssembleConstant(fc_prev);
+      ++reuse_count_;
+    } else {
+      AssembleOperator(fc_prev);
+    }
+
+    // Assemble the system
+#pragma omp parallel
+    for (auto& run : mesh.ActiveCells().GetRuns()) {
+#pragma omp for nowait
+      for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+        IdxCell idxcell(i);
+        Expr& eqn = fc_system_[idxcell];
+        eqn = fc_operator_[idxcell] - Expr((*this->p_fc_source_)[idxcell]);
+        if (p_fc_sink_) {
+          eqn[eqn.Find(idxcell)].coeff += (*p_fc_sink_)[idxcell];
+        }
 
         // Convert to delta-form
         eqn.SetConstant(eqn.Evaluate(fc_prev));
 
         // Apply under-relaxation
         eqn[eqn.Find(idxcell)].coeff /= relaxation_factor_;
-      } else {
-        eqn.Clear();
-        eqn.InsertTerm(1., idxcell);
-        eqn.SetConstant(0.);
       }
     }
 
@@ -242,7 +452,7 @@ class ConvectionDiffusionScalarImplicit :
       }
     }
 
-    fc_corr_ = linear_->Solve(fc_system_);
+    fc_corr_ = Solve(*linear_, fc_system_, active_);
     for (auto idxcell : mesh.Cells()) {
       fc_curr[idxcell] = fc_prev[idxcell] + fc_corr_[idxcell];
     }
@@ -250,8 +460,7 @@ class ConvectionDiffusionScalarImplicit :
     this->IncIterationCount();
   }
   void FinishStep() override {
-    fc_field_.time_prev = fc_field_.time_curr;
-    fc_field_.time_curr = fc_field_.iter_curr;
+    fc_field_.RotateTime();
     if (IsNan(fc_field_.time_curr)) {
       throw std::string("NaN field");
     }
@@ -0,0 +1,290 @@
+/*
+ * field_expr.hpp
+ *
+ * Lazy arithmetic on fields. Operators on fields build expressions
+ * which are evaluated element by element in one loop on assignment
+ * to a field, so that a multi-term update makes one pass over memory.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+namespace geom {
+
+// Tag of all field expressions
+class FieldExprBase {};
+
+// Base of expression E with elements indexed by Idx.
+// E provides size(), Eval(size_t i) returning element i,
+// and type ExprRef used to hold E inside other expressions
+// (a reference for fields, a copy for temporary expressions).
+template <class E, class Idx>
+class FieldExpr : public FieldExprBase {
+ public:
+  using IdxType = Idx;
+  const E& Self() const {
+    return static_cast<const E&>(*this);
+  }
+};
+
+template <class T>
+using IsFieldExpr =
+    std::is_base_of<FieldExprBase, typename std::decay<T>::type>;
+
+// Element type of expression E
+template <class E>
+using FieldExprValue =
+    typename std::decay<decltype(std::declval<const E&>().Eval(0))>::type;
+
+// Type to accumulate sums of values of type T:
+// double for float (mixed precision), T otherwise
+template <class T>
+struct FieldAccum {
+  using type = T;
+};
+
+template <>
+struct FieldAccum<float> {
+  using type = double;
+};
+
+template <class T>
+using FieldAccumType = typename FieldAccum<T>::type;
+
+// Same value for every element (constant operand of a binary operation)
+template <class T, class Idx>
+class FieldExprConst : public FieldExpr<FieldExprConst<T, Idx>, Idx> {
+  T value_;
+  size_t size_;
+
+ public:
+  using ExprRef = FieldExprConst;
+  FieldExprConst(const T& value, size_t size)
+      : value_(value)
+      , size_(size)
+  {}
+  size_t size() const {
+    return size_;
+  }
+  const T& Eval(size_t) const {
+    return value_;
+  }
+};
+
+template <class A, class Op, class Idx>
+class FieldExprUnary : public FieldExpr<FieldExprUnary<A, Op, Idx>, Idx> {
+  typename A::ExprRef a_;
+
+ public:
+  using ExprRef = FieldExprUnary;
+  explicit FieldExprUnary(const A& a)
+      : a_(a)
+  {}
+  size_t size() const {
+    return a_.size();
+  }
+  auto Eval(size_t i) const
+      -> decltype(Op::Apply(std::declval<FieldExprValue<A>>())) {
+    return Op::Apply(a_.Eval(i));
+  }
+};
+
+template <class A, class B, class Op, class Idx>
+class FieldExprBinary :
+    public FieldExpr<FieldExprBinary<A, B, Op, Idx>, Idx> {
+  typename A::ExprRef a_;
+  typename B::ExprRef b_;
+
+ public:
+  using ExprRef = FieldExprBinary;
+  FieldExprBinary(const A& a, const B& b)
+      : a_(a)
+      , b_(b)
+  {
+#ifdef __RANGE_CHECK
+    assert(a.size() == b.size());
+#endif
+  }
+  size_t size() const {
+    return a_.size();
+  }
+  auto Eval(size_t i) const
+      -> decltype(Op::Apply(std::declval<FieldExprValue<A>>(),
+                            std::declval<FieldExprValue<B>>())) {
+    return Op::Apply(a_.Eval(i), b_.Eval(i));
+  }
+};
+
+// Sum of terms of the same type,
+// e.g. over phases with the number of phases known at run time.
+// Holds a reference to terms.
+template <class E, class Idx>
+class FieldExprSum : public FieldExpr<FieldExprSum<E, Idx>, Idx> {
+  const std::vector<E>& terms_;
+  size_t size_;
+
+ public:
+  using ExprRef = FieldExprSum;
+  FieldExprSum(const std::vector<E>& terms, size_t size)
+      : terms_(terms)
+      , size_(size)
+  {}
+  size_t size() const {
+    return size_;
+  }
+  FieldExprValue<E> Eval(size_t i) const {
+    FieldExprValue<E> sum(0);
+    for (auto& term : terms_) {
+      sum += term.Eval(i);
+    }
+    return sum;
+  }
+};
+
+struct FieldOpNeg {
+  template <class A>
+  static auto Apply(const A& a) -> decltype(-a) {
+    return -a;
+  }
+};
+
+struct FieldOpAdd {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) -> decltype(a + b) {
+    return a + b;
+  }
+};
+
+struct FieldOpSub {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) -> decltype(a - b) {
+    return a - b;
+  }
+};
+
+struct FieldOpMul {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) -> decltype(a * b) {
+    return a * b;
+  }
+};
+
+struct FieldOpDiv {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) -> decltype(a / b) {
+    return a / b;
+  }
+};
+
+struct FieldOpDot {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) -> decltype(a.dot(b)) {
+    return a.dot(b);
+  }
+};
+
+template <class E, class Idx>
+FieldExprUnary<E, FieldOpNeg, Idx>
+operator-(const FieldExpr<E, Idx>& a) {
+  return FieldExprUnary<E, FieldOpNeg, Idx>(a.Self());
+}
+
+// Binary operations: field with field, field with constant
+// and constant with field. Constant is any type which is not
+// an expression (e.g. Scal or Vect).
+#define FIELD_EXPR_BINARY(OPERATOR, OP)                                     \
+template <class A, class B, class Idx>                                      \
+FieldExprBinary<A, B, OP, Idx>                                              \
+OPERATOR(const FieldExpr<A, Idx>& a, const FieldExpr<B, Idx>& b) {          \
+  return FieldExprBinary<A, B, OP, Idx>(a.Self(), b.Self());                \
+}                                                                           \
+template <class A, class C, class Idx,                                      \
+          class = typename std::enable_if<!IsFieldExpr<C>::value>::type>    \
+FieldExprBinary<A, FieldExprConst<C, Idx>, OP, Idx>                         \
+OPERATOR(const FieldExpr<A, Idx>& a, const C& c) {                          \
+  return FieldExprBinary<A, FieldExprConst<C, Idx>, OP, Idx>(               \
+      a.Self(), FieldExprConst<C, Idx>(c, a.Self().size()));                \
+}                                                                           \
+template <class C, class B, class Idx,                                      \
+          class = typename std::enable_if<!IsFieldExpr<C>::value>::type>    \
+FieldExprBinary<FieldExprConst<C, Idx>, B, OP, Idx>                         \
+OPERATOR(const C& c, const FieldExpr<B, Idx>& b) {                          \
+  return FieldExprBinary<FieldExprConst<C, Idx>, B, OP, Idx>(               \
+      FieldExprConst<C, Idx>(c, b.Self().size()), b.Self());                \
+}
+
+FIELD_EXPR_BINARY(operator+, FieldOpAdd)
+FIELD_EXPR_BINARY(operator-, FieldOpSub)
+FIELD_EXPR_BINARY(operator*, FieldOpMul)
+FIELD_EXPR_BINARY(operator/, FieldOpDiv)
+FIELD_EXPR_BINARY(Dot, FieldOpDot)
+
+#undef FIELD_EXPR_BINARY
+
+// Sum of expressions (or fields) of the same type, evaluated in one pass.
+// Zero of the given size if terms is empty.
+// Terms must exist until the expression is evaluated.
+template <class E>
+FieldExprSum<E, typename E::IdxType> Sum(const std::vector<E>& terms,
+                                         size_t size) {
+  return FieldExprSum<E, typename E::IdxType>(terms, size);
+}
+
+// Reductions over all elements.
+// Partial sums over a fixed number of chunks are combined in order,
+// so the result does not depend on the number of threads.
+// Single precision values are accumulated in double.
+template <class E, class Idx>
+FieldExprValue<E> Sum(const FieldExpr<E, Idx>& expr) {
+  using T = FieldAccumType<FieldExprValue<E>>;
+  const E& e = expr.Self();
+  const size_t n = e.size();
+  const std::ptrdiff_t nchunks = 64;
+  std::vector<T> partial(nchunks, T(0));
+#pragma omp parallel for
+  for (std::ptrdiff_t c = 0; c < nchunks; ++c) {
+    const size_t begin = n * c / nchunks;
+    const size_t end = n * (c + 1) / nchunks;
+    T sum(0);
+    for (size_t i = begin; i < end; ++i) {
+      sum += e.Eval(i);
+    }
+    partial[c] = sum;
+  }
+  T res(0);
+  for (auto& p : partial) {
+    res += p;
+  }
+  return FieldExprValue<E>(res);
+}
+
+// Maximum and minimum of a scalar expression, which must not be empty
+template <class E, class Idx>
+FieldExprValue<E> Max(const FieldExpr<E, Idx>& expr) {
+  const E& e = expr.Self();
+  assert(e.size() > 0);
+  FieldExprValue<E> res = e.Eval(0);
+  for (size_t i = 1; i < e.size(); ++i) {
+    res = std::max<FieldExprValue<E>>(res, e.Eval(i));
+  }
+  return res;
+}
+
+template <class E, class Idx>
+FieldExprValue<E> Min(const FieldExpr<E, Idx>& expr) {
+  const E& e = expr.Self();
+  assert(e.size() > 0);
+  FieldExprValue<E> res = e.Eval(0);
+  for (size_t i = 1; i < e.size(); ++i) {
+    res = std::min<FieldExprValue<E>>(res, e.Eval(i));
+  }
+  return res;
+}
+
+} // namespace geom
@@ -54,7 +54,7 @@ class ConvectionDiffusion : public UnsteadyIterativeSolver {
   virtual const geom::FieldCell<Vect>& GetVelocity() = 0;
   virtual const geom::FieldCell<Vect>& GetVelocity(Layers layer) = 0;
   virtual void CorrectVelocity(Layers layer,
-                               const geom::FieldCell<Vect>& fc_corr) = 0;
+                               const geom::FieldCellSoA<Vect>& fc_corr) = 0;
   virtual const geom::FieldCell<Expr>& GetVelocityEquations(size_t comp) = 0;
 };
 
@@ -80,14 +80,27 @@ class ConvectionDiffusionImplicit : public ConvectionDiffusion<Mesh> {
   // TODO: Extract scalar CellCondition
   VectGeneric<std::shared_ptr<Solver>>
   v_solver_;
-  VectGeneric<geom::FieldCell<Scal>>
-  v_fc_force_;
+  // Force components (referenced by solvers)
+  geom::FieldCellSoA<Vect> fc_force_;
+  geom::FieldCell<Vect>* p_fc_sink_;
+  // Implicit sink components (referenced by solvers)
+  geom::FieldCellSoA<Vect> fc_sink_;
 
  public:
+  // Gathers components from solvers in one pass
   void CopyToVector(Layers layer) {
-    fc_velocity_.Get(layer).Reinit(mesh);
+    auto& fc = fc_velocity_.Get(layer);
+    fc.Reinit(mesh);
+    VectGeneric<const Scal*> d;
     for (size_t n = 0; n < dim; ++n) {
-      SetComponent(fc_velocity_.Get(layer), n, v_solver_[n]->GetField(layer));
+      d[n] = v_solver_[n]->GetField(layer).data();
+    }
+#pragma omp parallel for schedule(static)
+    for (IntIdx i = 0; i < static_cast<IntIdx>(fc.size()); ++i) {
+      Vect& v = fc[IdxCell(i)];
+      for (size_t n = 0; n < dim; ++n) {
+        v[n] = d[n][i];
+      }
     }
   }
   ConvectionDiffusionImplicit(
@@ -107,7 +120,10 @@ class ConvectionDiffusionImplicit : public ConvectionDiffusion<Mesh> {
     double convergence_tolerance,
     size_t num_iterations_limit,
     bool time_second_order = true,
-    Scal guess_extrapolation = 0.)
+    Scal guess_extrapolation = 0.,
+    size_t reuse_limit = 0,
+    Scal reuse_flux_threshold = 0.,
+    geom::FieldCell<Vect>* p_fc_sink = nullptr)
     : ConvectionDiffusion<Mesh>(
         time, time_step, p_fc_density, p_ff_kinematic_viscosity, p_fc_force,
         p_ff_vol_flux,
@@ -116,7 +132,12 @@ class ConvectionDiffusionImplicit : public ConvectionDiffusion<Mesh> {
       , mf_velocity_cond_(mf_velocity_cond)
       , mc_velocity_cond_(mc_velocity_cond)
       , p_fc_force_(p_fc_force)
+      , p_fc_sink_(p_fc_sink)
   {
+    geom::FieldCellSoA<Vect> fc_initial;
+    fc_initial = fc_velocity_initial;
+    fc_force_.Reinit(mesh);
+    fc_sink_.Reinit(mesh);
     for (size_t n = 0; n < dim; ++n) {
       // Boundary conditions for each velocity component
       // (copied from given vector conditions)
@@ -135,13 +156,15 @@ class ConvectionDiffusionImplicit : public ConvectionDiffusion<Mesh> {
 
       // Initialize solver
       v_solver_[n] = std::make_shared<Solver>(
-          mesh, GetComponent(fc_velocity_initial, n),
+          mesh, fc_initial[n],
           v_mf_velocity_cond_[n],
           geom::MapCell<std::shared_ptr<ConditionCell>>() /*empty*/,
           relaxation_factor, p_fc_density, p_ff_kinematic_viscosity,
-          &(v_fc_force_[n]), p_ff_vol_flux, time, time_step,
+          &(fc_force_[n]), p_ff_vol_flux, time, time_step,
           linear_factory, convergence_tolerance,
-          num_iterations_limit, time_second_order, guess_extrapolation);
+          num_iterations_limit, time_second_order, guess_extrapolation,
+          reuse_limit, reuse_flux_threshold,
+          p_fc_sink_ ? &(fc_sink_[n]) : nullptr);
     }
     CopyToVector(Layers::time_curr);
     CopyToVector(Layers::time_prev);
@@ -155,11 +178,15 @@ class ConvectionDiffusionImplicit : public ConvectionDiffusion<Mesh> {
     this->ClearIterationCount();
   }
   void MakeIteration() override {
+    fc_force_ = *p_fc_force_;
+    if (p_fc_sink_) {
+      fc_sink_ = *p_fc_sink_;
+    }
     for (size_t n = 0; n < dim; ++n) {
-      v_fc_force_[n] = GetComponent(*p_fc_force_, n);
       v_solver_[n]->MakeIteration();
     }
-    CopyToVector(Layers::iter_prev);
+    // iter_prev of components is the previous iter_curr
+    fc_velocity_.RotateIter();
     CopyToVector(Layers::iter_curr);
     this->IncIterationCount();
   }
@@ -167,8 +194,8 @@ class ConvectionDiffusionImplicit : public ConvectionDiffusion<Mesh> {
     for (size_t n = 0; n < dim; ++n) {
       v_solver_[n]->FinishStep();
     }
-    CopyToVector(Layers::time_prev);
-    CopyToVector(Layers::time_curr);
+    // Time layers of components are rotated the same way
+    fc_velocity_.RotateTime();
     this->IncTime();
   }
   double GetConvergenceIndicator() const override {
@@ -183,10 +210,14 @@ class ConvectionDiffusionImplicit : public ConvectionDiffusion<Mesh> {
   const geom::FieldCell<Vect>& GetVelocity(Layers layer) override {
     return fc_velocity_.Get(layer);
   }
+  // Component n of velocity (field of the solver, not a copy)
+  const geom::FieldCell<Scal>& GetVelocityComponent(Layers layer, size_t n) {
+    return v_solver_[n]->GetField(layer);
+  }
   void CorrectVelocity(Layers layer,
-                       const geom::FieldCell<Vect>& fc_corr) override {
+                       const geom::FieldCellSoA<Vect>& fc_corr) override {
     for (size_t n = 0; n < dim; ++n) {
-      v_solver_[n]->CorrectField(layer, GetComponent(fc_corr, n));
+      v_solver_[n]->CorrectField(layer, fc_corr[n]);
     }
     CopyToVector(layer);
   }
@@ -430,6 +461,7 @@ class FluidSimple : public FluidSolver<Mesh> {
   using Expr = Expression<Scal, IdxCell, 1 + dim * 2>;
 
   geom::FieldCell<Vect> fc_force_;
+  geom::FieldCell<Vect> fc_sink_; // implicit sink, axisymmetric only
   Scal velocity_relaxation_factor_;
   Scal pressure_relaxation_factor_;
   Scal rhie_chow_factor_;
@@ -455,11 +487,21 @@ class FluidSimple : public FluidSolver<Mesh> {
 
   geom::MapFace<std::shared_ptr<ConditionFace>> mf_viscosity_cond_;
 
+  // Face conditions compiled for kernels
+  ConditionFaceTable<Vect, Mesh> mf_velocity_table_;
+  ConditionFaceTable<Scal, Mesh> mf_pressure_table_;
+  ConditionFaceTable<Vect, Mesh> mf_pressure_grad_table_;
+  ConditionFaceTable<Vect, Mesh> mf_force_table_;
+  ConditionFaceTable<Scal, Mesh> mf_pressure_corr_table_;
+  ConditionFaceTable<Scal, Mesh> mf_viscosity_table_;
+  std::vector<ConditionFaceTable<Scal, Mesh>> v_mf_velocity_table_;
+
   geom::MapCell<std::shared_ptr<ConditionCellFluid>> mc_cond_;
   geom::MapCell<std::shared_ptr<ConditionCell>> mc_pressure_cond_;
   geom::MapCell<std::shared_ptr<ConditionCell>> mc_velocity_cond_;
 
   std::shared_ptr<LinearSolver<Scal, IdxCell, Expr>> linear_;
+  CompactNumbering<IdxCell> active_; // cells not excluded
 
   geom::FieldFace<bool> is_boundary_;
 
@@ -477,6 +519,7 @@ class FluidSimple : public FluidSolver<Mesh> {
   geom::FieldCell<Expr> fc_pressure_corr_system_;
   geom::FieldCell<Scal> fc_pressure_corr_;
   geom::FieldCell<Vect> fc_pressure_corr_grad_;
+  geom::FieldCellSoA<Vect> fc_velocity_corr_;
   geom::FieldFace<Vect> ff_ext_force_;
   geom::FieldCell<Vect> fc_ext_force_restored_;
   geom::FieldFace<Vect> ff_ext_force_restored_;
@@ -489,6 +532,8 @@ class FluidSimple : public FluidSolver<Mesh> {
   bool simpler_;
   bool force_geometric_average_;
   Scal guess_extrapolation_;
+  size_t momentum_reuse_limit_;
+  Scal momentum_reuse_flux_threshold_;
 
   void UpdateDerivedConditions() {
     using namespace fluid_condition;
@@ -539,13 +584,34 @@ class FluidSimple : public FluidSolver<Mesh> {
     }
   }
   // TODO: Think about seperate canals in one domain
+  void CompileConditionTables() {
+    mf_velocity_table_.Compile(mf_velocity_cond_, mesh);
+    mf_pressure_table_.Compile(mf_pressure_cond_, mesh);
+    mf_pressure_grad_table_.Compile(mf_pressure_grad_cond_, mesh);
+    mf_force_table_.Compile(mf_force_cond_, mesh);
+    mf_pressure_corr_table_.Compile(mf_pressure_corr_cond_, mesh);
+    mf_viscosity_table_.Compile(mf_viscosity_cond_, mesh);
+    v_mf_velocity_table_.resize(dim);
+    for (size_t n = 0; n < dim; ++n) {
+      v_mf_velocity_table_[n].Compile(
+          conv_diff_solver_->GetVelocityCond(n), mesh);
+    }
+  }
+  // Copies values of conditions changed by UpdateDerivedConditions()
+  void UpdateConditionTables() {
+    mf_velocity_table_.Update();
+    for (auto& table : v_mf_velocity_table_) {
+      table.Update();
+    }
+  }
   void UpdateOutletBaseConditions() {
     using namespace fluid_condition;
     // Extrapolate velocity on outlet faces from cell centers
     // and calculate total inlet and outlet volumetric fluxes
-    Scal inlet_volume_flux = 0.;   // Both should be positive
-    Scal outlet_volume_flux = 0.;
-    Scal outlet_area = 0.;
+    // Both should be positive
+    geom::FieldAccumType<Scal> inlet_volume_flux = 0.;
+    geom::FieldAccumType<Scal> outlet_volume_flux = 0.;
+    geom::FieldAccumType<Scal> outlet_area = 0.;
     for (auto it = mf_cond_.cbegin();
         it != mf_cond_.cend(); ++it) {
       IdxFace idxface = it->GetIdx();
@@ -590,7 +656,7 @@ class FluidSimple : public FluidSolver<Mesh> {
         size_t id = cond->GetNeighbourCellId();
         Scal factor = (id == 0 ? 1. : -1.);
 
-        Vect normal = mesh.GetSurface(idxface) / mesh.GetArea(idxface);
+        Vect normal = mesh.GetNormal(idxface);
 
         cond->SetVelocity(
             cond->GetVelocity() +
@@ -602,12 +668,10 @@ class FluidSimple : public FluidSolver<Mesh> {
   void CalcExtForce() {
     timer_->Push("fluid.1.force-correction");
     // Interpolate force to faces (considered as given force)
-    ff_ext_force_ = Interpolate(
-        *this->p_fc_force_, mf_force_cond_, mesh,
-        force_geometric_average_);
-    ff_stforce_restored_ = Interpolate(
-        *this->p_fc_stforce_, mf_force_cond_, mesh,
-        force_geometric_average_);
+    Interpolate(*this->p_fc_force_, mf_force_table_, mesh,
+                ff_ext_force_, force_geometric_average_);
+    Interpolate(*this->p_fc_stforce_, mf_force_table_, mesh,
+                ff_stforce_restored_, force_geometric_average_);
     fc_ext_force_restored_.Reinit(mesh);
 
 #pragma omp parallel for
@@ -624,9 +688,8 @@ class FluidSimple : public FluidSolver<Mesh> {
       fc_ext_force_restored_[idxcell] = sum / mesh.GetVolume(idxcell);
     }
     // Interpolated restored force to faces (needed later)
-    ff_ext_force_restored_ = Interpolate(
-        fc_ext_force_restored_, mf_force_cond_, mesh,
-        force_geometric_average_);
+    Interpolate(fc_ext_force_restored_, mf_force_table_, mesh,
+                ff_ext_force_restored_, force_geometric_average_);
     timer_->Pop();
   }
   void CalcKinematicViscosity() {
@@ -635,9 +698,8 @@ class FluidSimple : public FluidSolver<Mesh> {
       fc_kinematic_viscosity_[idxcell] =
           (*this->p_fc_viscosity_)[idxcell];
     }
-    ff_kinematic_viscosity_ = Interpolate(
-        fc_kinematic_viscosity_, mf_viscosity_cond_, mesh,
-        force_geometric_average_);
+    Interpolate(fc_kinematic_viscosity_, mf_viscosity_table_, mesh,
+                ff_kinematic_viscosity_, force_geometric_average_);
   }
 
  public:
@@ -667,7 +729,9 @@ class FluidSimple : public FluidSolver<Mesh> {
               bool simpler,
               bool force_geometric_average,
               Scal guess_extrapolation = 0.,
-              Vect meshvel=0)
+              Vect meshvel=0,
+              size_t momentum_reuse_limit = 0,
+              Scal momentum_reuse_flux_threshold = 0.)
       : FluidSolver<Mesh>(time, time_step, p_fc_density, p_fc_viscosity,
                     p_fc_force, p_fc_stforce, p_ff_stforce,
                     p_fc_volume_source, p_fc_mass_source,
@@ -686,8 +750,22 @@ class FluidSimple : public FluidSolver<Mesh> {
       , simpler_(simpler)
       , force_geometric_average_(force_geometric_average)
       , guess_extrapolation_(guess_extrapolation)
+      , momentum_reuse_limit_(momentum_reuse_limit)
+      , momentum_reuse_flux_threshold_(momentum_reuse_flux_threshold)
   {
     linear_ = linear_factory_pressure.Create<Scal, IdxCell, Expr>();
+    active_ = CompactNumbering<IdxCell>(mesh.Cells().size(),
+                                        mesh.ActiveCells());
+
+    // Rows of excluded cells are identities, only active rows
+    // are assembled and solved
+    for (auto idxcell : mesh.Cells()) {
+      if (mesh.IsExcluded(idxcell)) {
+        auto& eqn = fc_pressure_corr_system_[idxcell];
+        eqn.InsertTerm(1., idxcell);
+        eqn.SetConstant(0.);
+      }
+    }
 
     using namespace fluid_condition;
 
@@ -762,7 +840,11 @@ class FluidSimple : public FluidSolver<Mesh> {
             time, time_step,
             linear_factory_velocity,
             convergence_tolerance, num_iterations_limit,
-            time_second_order_, guess_extrapolation_);
+            time_second_order_, guess_extrapolation_,
+            momentum_reuse_limit_, momentum_reuse_flux_threshold_,
+            mesh.IsAxisymmetric() ? &fc_sink_ : nullptr);
+
+    CompileConditionTables();
 
     fc_pressure_.time_curr.Reinit(mesh, 0.);
     fc_pressure_.time_prev = fc_pressure_.time_curr;
@@ -770,7 +852,7 @@ class FluidSimple : public FluidSolver<Mesh> {
     // Calc initial volume fluxes
     fc_velocity_asterisk_ = conv_diff_solver_->GetVelocity();
     ff_velocity_asterisk_ = Interpolate(
-        fc_velocity_asterisk_, mf_velocity_cond_, mesh);
+        fc_velocity_asterisk_, mf_velocity_table_, mesh);
     ff_vol_flux_.time_curr.Reinit(mesh, 0.);
     for (auto idxface : mesh.Faces()) {
       ff_vol_flux_.time_curr[idxface] =
@@ -785,10 +867,11 @@ class FluidSimple : public FluidSolver<Mesh> {
     ff_vol_flux_.time_prev = ff_vol_flux_.time_curr;
     ff_volume_flux_interpolated_.Reinit(mesh, 0.);
 
-    ff_pressure_ = Interpolate(fc_pressure_.time_curr, mf_pressure_cond_, mesh);
+    ff_pressure_ =
+        Interpolate(fc_pressure_.time_curr, mf_pressure_table_, mesh);
     fc_pressure_grad_ = Gradient(ff_pressure_, mesh);
     ff_pressure_grad_ = Interpolate(
-        fc_pressure_grad_, mf_pressure_grad_cond_, mesh);
+        fc_pressure_grad_, mf_pressure_grad_table_, mesh);
   }
   void StartStep() override {
     this->ClearIterationCount();
@@ -797,77 +880,84 @@ class FluidSimple : public FluidSolver<Mesh> {
     }
     conv_diff_solver_->SetTimeStep(this->GetTimeStep());
     conv_diff_solver_->StartStep();
-    fc_pressure_.iter_curr = fc_pressure_.time_curr;
-    ff_vol_flux_.iter_curr = ff_vol_flux_.time_curr;
-    for (auto idxcell : mesh.Cells()) {
-      fc_pressure_.iter_curr[idxcell] +=
-          (fc_pressure_.time_curr[idxcell] - fc_pressure_.time_prev[idxcell]) *
-          guess_extrapolation_;
-    }
-    for (auto idxface : mesh.Faces()) {
-      ff_vol_flux_.iter_curr[idxface] +=
-          (ff_vol_flux_.time_curr[idxface] - ff_vol_flux_.time_prev[idxface]) *
-          guess_extrapolation_;
-    }
+    fc_pressure_.iter_curr = fc_pressure_.time_curr +
+        (fc_pressure_.time_curr - fc_pressure_.time_prev) *
+        guess_extrapolation_;
+    ff_vol_flux_.iter_curr = ff_vol_flux_.time_curr +
+        (ff_vol_flux_.time_curr - ff_vol_flux_.time_prev) *
+        guess_extrapolation_;
   }
   // TODO: rewrite norm() using dist() where needed
   void MakeIteration() override {
     auto& fc_pressure_prev = fc_pressure_.iter_prev;
     auto& fc_pressure_curr = fc_pressure_.iter_curr;
-    fc_pressure_prev = fc_pressure_curr;
-    ff_vol_flux_.iter_prev = ff_vol_flux_.iter_curr;
+    fc_pressure_.RotateIter();
+    ff_vol_flux_.RotateIter();
 
     UpdateOutletBaseConditions();
     UpdateDerivedConditions();
+    UpdateConditionTables();
 
     CalcExtForce();
 
     CalcKinematicViscosity();
 
     timer_->Push("fluid.0.pressure-gradient");
-    ff_pressure_ = Interpolate(fc_pressure_prev, mf_pressure_cond_, mesh);
-    fc_pressure_grad_ = Gradient(ff_pressure_, mesh);
-    ff_pressure_grad_ = Interpolate(
-        fc_pressure_grad_, mf_pressure_grad_cond_, mesh);
+    Interpolate(fc_pressure_prev, mf_pressure_table_, mesh, ff_pressure_);
+    Gradient(ff_pressure_, mesh, fc_pressure_grad_);
+    Interpolate(fc_pressure_grad_, mf_pressure_grad_table_, mesh,
+                ff_pressure_grad_);
     timer_->Pop();
 
     // initialize force with zero
     fc_force_.Reinit(mesh, Vect(0));
     // append viscous term
     timer_->Push("fluid.1a.explicit-viscosity");
+    geom::FieldFaceBuffer<Scal> ff(mesh);
+    geom::FieldCellBuffer<Vect> gc(mesh);
+    geom::FieldFaceBuffer<Vect> gf(mesh);
     for (size_t n = 0; n < dim; ++n) {
-      geom::FieldCell<Scal> fc = GetComponent(
-          conv_diff_solver_->GetVelocity(Layers::iter_curr), n);
-      auto ff = Interpolate(fc, conv_diff_solver_->GetVelocityCond(n), mesh);
-      auto gc = Gradient(ff, mesh);
-      auto gf = Interpolate(gc, mf_force_cond_, mesh); // adhoc: zero-der cond
+      const auto& fc =
+          conv_diff_solver_->GetVelocityComponent(Layers::iter_curr, n);
+      Interpolate(fc, v_mf_velocity_table_[n], mesh, *ff);
+      Gradient(*ff, mesh, *gc);
+      Interpolate(*gc, mf_force_table_, mesh, *gf); // adhoc: zero-der cond
       for (auto idxcell : mesh.Cells()) {
         Vect sum = Vect::kZero;
         for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
           IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
-          sum += gf[idxface] * (ff_kinematic_viscosity_[idxface] * 
+          sum += (*gf)[idxface] * (ff_kinematic_viscosity_[idxface] * 
               mesh.GetOutwardSurface(idxcell, i)[n]);
         }
         fc_force_[idxcell] += sum / mesh.GetVolume(idxcell);
       }
     }
+    if (mesh.IsAxisymmetric()) {
+      // Hoop term of the viscous stress -2 mu u_r / r^2
+      // as implicit sink in the radial component
+      fc_sink_.Reinit(mesh, Vect(0));
+      for (auto idxcell : mesh.ActiveCells()) {
+        Scal mu = 0.;
+        const size_t nf = mesh.GetNumNeighbourFaces(idxcell);
+        for (size_t i = 0; i < nf; ++i) {
+          mu += ff_kinematic_viscosity_[mesh.GetNeighbourFace(idxcell, i)];
+        }
+        mu /= nf;
+        Scal hoop = mesh.GetHoopFactor(idxcell);
+        fc_sink_[idxcell][0] = 2. * mu * hoop * hoop;
+      }
+    }
     timer_->Pop();
 
     // append to force
-#pragma omp parallel for
-    for (IntIdx i = 0; i < static_cast<IntIdx>(mesh.Cells().size()); ++i) {
-      IdxCell idxcell(i);
-    //for (auto idxcell : mesh.Cells()) {
-      fc_force_[idxcell] +=
-          fc_pressure_grad_[idxcell] * (-1.) +
-          fc_ext_force_restored_[idxcell] +
-          (*this->p_fc_stforce_)[idxcell] +
-          // Volume source momentum compensation:
-          conv_diff_solver_->GetVelocity(Layers::iter_curr)[idxcell] *
-          ((*this->p_fc_density_)[idxcell] *
-          (*this->p_fc_volume_source_)[idxcell] -
-          (*this->p_fc_mass_source_)[idxcell]);
-    }
+    fc_force_ +=
+        fc_pressure_grad_ * (-1.) +
+        fc_ext_force_restored_ +
+        *this->p_fc_stforce_ +
+        // Volume source momentum compensation:
+        conv_diff_solver_->GetVelocity(Layers::iter_curr) *
+        (*this->p_fc_density_ * *this->p_fc_volume_source_ -
+        *this->p_fc_mass_source_);
 
     timer_->Push("fluid.2.convection-diffusion");
     conv_diff_solver_->MakeIteration();
@@ -883,13 +973,12 @@ class FluidSimple : public FluidSolver<Mesh> {
     }
 
     // Define ff_diag_coeff_ on inner faces only
-    ff_diag_coeff_ = Interpolate(
-        fc_diag_coeff_, geom::MapFace<std::shared_ptr<ConditionFace>>(), mesh);
+    InterpolateInner(fc_diag_coeff_, mesh, ff_diag_coeff_);
 
     fc_velocity_asterisk_ = conv_diff_solver_->GetVelocity(Layers::iter_curr);
 
-    ff_velocity_asterisk_ = Interpolate(
-        fc_velocity_asterisk_, mf_velocity_cond_, mesh);
+    Interpolate(fc_velocity_asterisk_, mf_velocity_table_, mesh,
+                ff_velocity_asterisk_);
 
     // // needed for MMIM, now disabled
     //ff_velocity_iter_prev_ = Interpolate(
@@ -970,11 +1059,12 @@ class FluidSimple : public FluidSolver<Mesh> {
     timer_->Pop();
 
     timer_->Push("fluid.5.pressure-system");
-#pragma omp parallel for
-    for (IntIdx i = 0; i < static_cast<IntIdx>(mesh.Cells().size()); ++i) {
-      IdxCell idxcell(i);
-      auto& eqn = fc_pressure_corr_system_[idxcell];
-      if (!mesh.IsExcluded(idxcell)) {
+#pragma omp parallel
+    for (auto& run : mesh.ActiveCells().GetRuns()) {
+#pragma omp for nowait
+      for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+        IdxCell idxcell(i);
+        auto& eqn = fc_pressure_corr_system_[idxcell];
         Expr flux_sum;
         for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
           IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
@@ -986,10 +1076,6 @@ class FluidSimple : public FluidSolver<Mesh> {
             flux_sum -
             Expr((*this->p_fc_volume_source_)[idxcell] *
                  mesh.GetVolume(idxcell));
-      } else {
-        eqn.Clear();
-        eqn.InsertTerm(1., idxcell);
-        eqn.SetConstant(0.);
       }
     }
 
@@ -999,7 +1085,7 @@ class FluidSimple : public FluidSolver<Mesh> {
       IdxCell idxcell(it->GetIdx());
       ConditionCell* cond = it->GetValue().get();
       if (auto cond_value = dynamic_cast<ConditionCellValue<Scal>*>(cond)) {
-        for (auto idxlocal : mesh.Cells()) {
+        for (auto idxlocal : mesh.ActiveCells()) {
           auto& eqn = fc_pressure_corr_system_[idxlocal];
           if (idxlocal == idxcell) {
             eqn.Clear();
@@ -1027,27 +1113,21 @@ class FluidSimple : public FluidSolver<Mesh> {
     timer_->Pop();
 
     timer_->Push("fluid.6.pressure-solve");
-    fc_pressure_corr_ = linear_->Solve(fc_pressure_corr_system_);
+    fc_pressure_corr_ =
+        Solve(*linear_, fc_pressure_corr_system_, active_);
     timer_->Pop();
 
     timer_->Push("fluid.7.correction");
     // Correct pressure
-    for (auto idxcell : mesh.Cells()) {
-      fc_pressure_curr[idxcell] = fc_pressure_prev[idxcell] +
-          pressure_relaxation_factor_ * fc_pressure_corr_[idxcell];
-    }
+    fc_pressure_curr =
+        fc_pressure_prev + pressure_relaxation_factor_ * fc_pressure_corr_;
 
-    fc_pressure_corr_grad_ = Gradient(
-        Interpolate(fc_pressure_corr_, mf_pressure_corr_cond_, mesh),
-        mesh);
+    Interpolate(fc_pressure_corr_, mf_pressure_corr_table_, mesh, *ff);
+    Gradient(*ff, mesh, fc_pressure_corr_grad_);
 
     // Correct the velocity
-    geom::FieldCell<Vect> fc_velocity_corr(mesh);
-    for (auto idxcell : mesh.Cells()) {
-      fc_velocity_corr[idxcell] =
-          fc_pressure_corr_grad_[idxcell] / (-fc_diag_coeff_[idxcell]);
-    }
-    conv_diff_solver_->CorrectVelocity(Layers::iter_curr, fc_velocity_corr);
+    fc_velocity_corr_ = fc_pressure_corr_grad_ / (-fc_diag_coeff_);
+    conv_diff_solver_->CorrectVelocity(Layers::iter_curr, fc_velocity_corr_);
 
     // Calc divergence-free volume fluxes
     for (auto idxface : mesh.Faces()) {
@@ -1068,7 +1148,7 @@ class FluidSimple : public FluidSolver<Mesh> {
       // Evaluate momentum equations using new velocity
       geom::FieldFace<Vect> ff_velocity(mesh);
       ff_velocity = Interpolate(
-          fc_velocity, mf_velocity_cond_, mesh);
+          fc_velocity, mf_velocity_table_, mesh);
 
       auto fc_velocity_delta = fc_velocity;
 #pragma omp parallel for
@@ -1092,8 +1172,8 @@ class FluidSimple : public FluidSolver<Mesh> {
             fc_ext_force_restored_[idxcell] - fc_pressure_grad_[idxcell];
       }
 
-      auto ff_evaluated = Interpolate(
-          fc_evaluated, geom::MapFace<std::shared_ptr<ConditionFace>>(), mesh);
+      geom::FieldFace<Vect> ff_evaluated;
+      InterpolateInner(fc_evaluated, mesh, ff_evaluated);
 
       geom::FieldFace<Scal> ff_rhs(mesh, 0);
 #pragma omp parallel for
@@ -1109,15 +1189,18 @@ class FluidSimple : public FluidSolver<Mesh> {
         }
       }
 
-#pragma omp parallel for
-      for (IntIdx rawcell = 0; rawcell < static_cast<IntIdx>(mesh.Cells().size()); ++rawcell) {
-        IdxCell idxcell(rawcell);
-        Scal sum = 0.;
-        for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
-          IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
-          sum += ff_rhs[idxface] * mesh.GetOutwardFactor(idxcell, i);
+#pragma omp parallel
+      for (auto& run : mesh.ActiveCells().GetRuns()) {
+#pragma omp for nowait
+        for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+          IdxCell idxcell(i);
+          Scal sum = 0.;
+          for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
+            IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
+            sum += ff_rhs[idxface] * mesh.GetOutwardFactor(idxcell, i);
+          }
+          fc_pressure_corr_system_[idxcell].SetConstant(-sum);
         }
-        fc_pressure_corr_system_[idxcell].SetConstant(-sum);
       }
 
       // Account for cell conditions for pressure
@@ -1126,7 +1209,7 @@ class FluidSimple : public FluidSolver<Mesh> {
         IdxCell idxcell(it->GetIdx());
         ConditionCell* cond = it->GetValue().get();
         if (auto cond_value = dynamic_cast<ConditionCellValue<Scal>*>(cond)) {
-          for (auto idxlocal : mesh.Cells()) {
+          for (auto idxlocal : mesh.ActiveCells()) {
             auto& eqn = fc_pressure_corr_system_[idxlocal];
             if (idxlocal == idxcell) {
               eqn.Clear();
@@ -1140,16 +1223,15 @@ class FluidSimple : public FluidSolver<Mesh> {
         }
       }
 
-      for (auto idxcell : mesh.Cells()) {
+      for (auto idxcell : mesh.ActiveCells()) {
         auto& eqn = fc_pressure_corr_system_[idxcell];
         eqn.SetConstant(eqn.Evaluate(fc_pressure_curr));
       }
 
-      fc_pressure_corr_ = linear_->Solve(fc_pressure_corr_system_);
+      fc_pressure_corr_ =
+          Solve(*linear_, fc_pressure_corr_system_, active_);
 
-      for (auto idxcell : mesh.Cells()) {
-        fc_pressure_curr[idxcell] += fc_pressure_corr_[idxcell];
-      }
+      fc_pressure_curr += fc_pressure_corr_;
 
       timer_->Pop();
     }
@@ -1157,10 +1239,8 @@ class FluidSimple : public FluidSolver<Mesh> {
     this->IncIterationCount();
   }
   void FinishStep() override {
-    fc_pressure_.time_prev = fc_pressure_.time_curr;
-    ff_vol_flux_.time_prev = ff_vol_flux_.time_curr;
-    fc_pressure_.time_curr = fc_pressure_.iter_curr;
-    ff_vol_flux_.time_curr = ff_vol_flux_.iter_curr;
+    fc_pressure_.RotateTime();
+    ff_vol_flux_.RotateTime();
     if (IsNan(fc_pressure_.time_curr)) {
       throw std::string("NaN pressure");
     }
@@ -1191,14 +1271,12 @@ class FluidSimple : public FluidSolver<Mesh> {
   double GetAutoTimeStep() override { 
     double dt = 1e10;
     auto& flux = ff_vol_flux_.time_curr;
-    for (auto idxcell : mesh.Cells()) {
-      if (!mesh.IsExcluded(idxcell)) {
-        for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
-          IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
-          if (flux[idxface] != 0.) {
-            dt = std::min(dt, 
-                std::abs(mesh.GetVolume(idxcell) / flux[idxface]));
-          }
+    for (auto idxcell : mesh.ActiveCells()) {
+      for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
+        IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
+        if (flux[idxface] != 0.) {
+          dt = std::min<double>(dt, 
+              std::abs(mesh.GetVolume(idxcell) / flux[idxface]));
         }
       }
     }
@@ -1240,10 +1318,16 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
   LayersData<FieldCell<Vect>> fc_velocity_;
   MultiTimer<std::string>* timer_;
 
+  // Cells of a local mesh form the box [cells_begin, cells_end)
+  // of global cells, the active cells form [active_begin, active_end).
+  // Cell fields are mapped between local and global meshes
+  // with strided views, without index tables.
   struct LocalData {
     Mesh mesh;
-    FieldCell<IdxCell> fc_global;
-    FieldCell<bool> fc_active;
+    MIdx cells_begin;
+    MIdx cells_end;
+    MIdx active_begin;
+    MIdx active_end;
     FieldFace<IdxFace> ff_global;
     FieldFace<bool> ff_active;
     std::shared_ptr<FluidSolver<Mesh>> fluid_solver;
@@ -1252,6 +1336,8 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
     FieldCell<Scal> fc_density;
     FieldCell<Scal> fc_viscosity;
     FieldCell<Vect> fc_force;
+    FieldCell<Vect> fc_stforce;
+    FieldFace<Vect> ff_stforce;
     FieldCell<Scal> fc_volume_source;
     FieldCell<Scal> fc_mass_source;
   };
@@ -1276,24 +1362,48 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
   std::vector<LocalData> local_;
 
  public:
+  // Global cell of local cell
+  IdxCell GetGlobalCell(const LocalData& local_data,
+                        IdxCell local_idxcell) const {
+    return global_mesh.GetBlockCells().GetIdx(
+        local_data.cells_begin +
+        local_data.mesh.GetBlockCells().GetMIdx(local_idxcell));
+  }
+  // View of global field indexed by cells of local mesh
+  template <class T>
+  geom::FieldCellView<const T, dim> GetLocalView(
+      const FieldCell<T>& global_field, const LocalData& local_data) const {
+    return geom::FieldCellView<const T, dim>(
+        global_field, global_mesh.GetBlockCells(), local_data.cells_begin,
+        local_data.cells_end - local_data.cells_begin);
+  }
   template <class T>
   void CopyToLocal(const FieldCell<T>& global_field,
                    FieldCell<T>& local_field,
                    const LocalData& local_data) {
+    local_field = GetLocalView(global_field, local_data);
+  }
+  template <class T>
+  void CopyToLocal(const FieldFace<T>& global_field,
+                   FieldFace<T>& local_field,
+                   const LocalData& local_data) {
     local_field.Reinit(local_data.mesh);
-    for (auto lidx : local_data.mesh.Cells()) {
-      local_field[lidx] = global_field[local_data.fc_global[lidx]];
+    for (auto idxface : local_data.mesh.Faces()) {
+      local_field[idxface] = global_field[local_data.ff_global[idxface]];
     }
   }
+  // Copies active cells
   template <class T>
   void CopyToGlobal(const FieldCell<T>& local_field,
                     const LocalData& local_data,
                     FieldCell<T>& global_field) {
-    for (auto idxcell : local_data.mesh.Cells()) {
-      if (local_data.fc_active[idxcell]) {
-        global_field[local_data.fc_global[idxcell]] = local_field[idxcell];
-      }
-    }
+    const MIdx size = local_data.active_end - local_data.active_begin;
+    geom::FieldCellView<T, dim>(
+        global_field, global_mesh.GetBlockCells(),
+        local_data.active_begin, size) =
+        geom::FieldCellView<const T, dim>(
+            local_field, local_data.mesh.GetBlockCells(),
+            local_data.active_begin - local_data.cells_begin, size);
   }
   template <class T>
   void CopyToGlobal(const FieldFace<T>& local_field,
@@ -1325,6 +1435,8 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
       CopyToLocal(*this->p_fc_density_, local.fc_density, local);
       CopyToLocal(*this->p_fc_viscosity_, local.fc_viscosity, local);
       CopyToLocal(*this->p_fc_force_, local.fc_force, local);
+      CopyToLocal(*this->p_fc_stforce_, local.fc_stforce, local);
+      CopyToLocal(*this->p_ff_stforce_, local.ff_stforce, local);
       CopyToLocal(*this->p_fc_volume_source_, local.fc_volume_source, local);
       CopyToLocal(*this->p_fc_mass_source_, local.fc_mass_source, local);
     }
@@ -1366,28 +1478,14 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
         IdxNode global_idxnode = global_bnodes.GetIdx(global_midx);
         local_fn_node[local_idxnode] = global_mesh.GetNode(global_idxnode);
       }
-      local_[part].mesh = Mesh(local_bnodes, local_fn_node);
+      local_[part].mesh = Mesh(local_bnodes, std::move(local_fn_node));
       auto& local = local_[part];
 
-      // Fill references to global cells
-      BlockCells local_bcells = local.mesh.GetBlockCells();
-      BlockCells global_bcells = global_mesh.GetBlockCells();
-      local.fc_global.Reinit(local.mesh);
-      local.fc_active.Reinit(local.mesh);
-      for (IdxCell local_idxcell : local.mesh.Cells()) {
-        MIdx local_midx = local_bcells.GetMIdx(local_idxcell);
-        MIdx global_midx = local_cells_begin + local_midx;
-        IdxCell global_idxcell = global_bcells.GetIdx(global_midx);
-        local.fc_global[local_idxcell] = global_idxcell;
-        local.fc_active[local_idxcell] =
-            (local_active_cells_begin <= global_midx &&
-                global_midx < local_active_cells_end);
-//        std::cout << "cell:"
-//            << "  local: " << local_midx << " " << local_idxcell.GetRaw()
-//            << "; global: " << global_midx << " " << global_idxcell.GetRaw()
-//            << "; " << (local.fc_active[local_idxcell] ? "active" : "overlap")
-//            << std::endl;
-      }
+      // Boxes of local and active cells
+      local.cells_begin = local_cells_begin;
+      local.cells_end = local_cells_end;
+      local.active_begin = local_active_cells_begin;
+      local.active_end = local_active_cells_end;
 
       // Fill references to global faces
       BlockFaces local_bfaces = local.mesh.GetBlockFaces();
@@ -1406,9 +1504,13 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
       }
 
       // Traverse all active cells and mark their neighbour faces active
+      BlockCells local_bcells = local.mesh.GetBlockCells();
       local.ff_active.Reinit(local.mesh, false);
       for (IdxCell local_idxcell : local.mesh.Cells()) {
-        if (local.fc_active[local_idxcell]) {
+        MIdx global_midx =
+            local_cells_begin + local_bcells.GetMIdx(local_idxcell);
+        if (local_active_cells_begin <= global_midx &&
+            global_midx < local_active_cells_end) {
           for (size_t k = 0;
               k < local.mesh.GetNumNeighbourFaces(local_idxcell); ++k) {
             local.ff_active[local.mesh.GetNeighbourFace(local_idxcell, k)] =
@@ -1428,9 +1530,10 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
         auto cond = it->GetValue().get();
         if (auto cond_ref =
             dynamic_cast<ConditionCellReferenceToGlobal*>(cond)) {
+          IdxCell global_idxcell = GetGlobalCell(local, idxcell);
           (*cond_ref) = ConditionCellReferenceToGlobal(
-              fc_velocity_.iter_curr[local.fc_global[idxcell]],
-              fc_pressure_.iter_curr[local.fc_global[idxcell]] -
+              fc_velocity_.iter_curr[global_idxcell],
+              fc_pressure_.iter_curr[global_idxcell] -
               fc_pressure_.iter_curr[idxcell_pressure_fixed]);
         }
       }
@@ -1460,9 +1563,12 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
         mc_cond
       , Scal velocity_relaxation_factor
       , Scal pressure_relaxation_factor
+      , Scal rhie_chow_factor
       , geom::FieldCell<Scal>* p_fc_density
       , geom::FieldCell<Scal>* p_fc_viscosity
       , geom::FieldCell<Vect>* p_fc_force
+      , geom::FieldCell<Vect>* p_fc_stforce
+      , geom::FieldFace<Vect>* p_ff_stforce
       , geom::FieldCell<Scal>* p_fc_volume_source
       , geom::FieldCell<Scal>* p_fc_mass_source
       , double time, double time_step
@@ -1471,12 +1577,16 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
       , double convergence_tolerance
       , size_t num_iterations_limit
       , MultiTimer<std::string>* timer
+      , bool time_second_order
+      , bool simpler
+      , bool force_geometric_average
       , size_t num_local_mesh
       , size_t overlap_width
       )
       : FluidSolver<Mesh>(time, time_step, p_fc_density, p_fc_viscosity,
-                    p_fc_force, p_fc_volume_source, p_fc_mass_source,
-                    convergence_tolerance, num_iterations_limit)
+                    p_fc_force, p_fc_stforce, p_ff_stforce,
+                    p_fc_volume_source, p_fc_mass_source,
+                    convergence_tolerance, num_iterations_limit, Vect(0))
       , global_mesh(mesh)
       , mf_cond_(mf_cond)
       , mc_cond_(mc_cond)
@@ -1506,7 +1616,7 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
           local.mf_cond[idxface] = *ptr;
         } else if (!local.mesh.IsInner(idxface)) {
           local.mf_cond[idxface] =
-              std::make_shared<ConditionFaceReferenceToGlobal>(Vect(0., 0.));
+              std::make_shared<ConditionFaceReferenceToGlobal>(Vect::kZero);
 //          auto idxcell = local.mesh.GetNeighbourCell(
 //              idxface, local.mesh.GetValidNeighbourCellId(idxface));
 //          local.mc_cond[idxcell] =
@@ -1521,7 +1631,7 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
       }
 
       for (IdxCell idxcell : local.mesh.Cells()) {
-        if (auto ptr = mc_cond_.find(local.fc_global[idxcell])) {
+        if (auto ptr = mc_cond_.find(GetGlobalCell(local, idxcell))) {
           local.mc_cond[idxcell] = *ptr;
         }
       }
@@ -1535,12 +1645,15 @@ class FluidSimpleParallel : public FluidSolver<Mesh> {
           local.mf_cond, local.mc_cond,
           velocity_relaxation_factor,
           pressure_relaxation_factor,
+          rhie_chow_factor,
           &local.fc_density, &local.fc_viscosity, &local.fc_force,
+          &local.fc_stforce, &local.ff_stforce,
           &local.fc_volume_source, &local.fc_mass_source,
           this->GetTime(), this->GetTimeStep(),
           linear_factory_velocity, linear_factory_pressure,
           convergence_tolerance, num_iterations_limit,
-          timer_);
+          timer_, time_second_order, simpler, force_geometric_average,
+          0., Vect(0));
     }
 
 
@@ -0,0 +1,289 @@
+/*
+ * ghost.hpp
+ *
+ * Cell fields with ghost layers filled from boundary conditions,
+ * so that stencil kernels need no special treatment of boundary faces.
+ */
+
+#pragma once
+
+#include "mesh.hpp"
+#include "solver.hpp"
+
+namespace solver {
+
+// Cell field on a block of cells extended by width ghost layers
+// on each side. Stored lexicographically, accessed by multi-index
+// relative to the same origin as the mesh block.
+template <class T, size_t dim>
+class FieldCellGhost {
+  using MIdx = geom::MIdxGeneral<dim>;
+  geom::BlockCells<dim> inner_;
+  IntIdx width_;
+  MIdx begin_; // first ghost cell
+  MIdx size_; // size including ghosts
+  std::vector<T> data_;
+
+ public:
+  FieldCellGhost() {}
+  FieldCellGhost(const geom::BlockCells<dim>& inner, IntIdx width)
+      : inner_(inner)
+      , width_(width)
+      , begin_(inner.GetBegin() - MIdx(width))
+      , size_(inner.GetDimensions() + MIdx(2 * width))
+  {
+    size_t n = 1;
+    for (size_t d = 0; d < dim; ++d) {
+      n *= size_[d];
+    }
+    data_.resize(n);
+  }
+  const geom::BlockCells<dim>& GetInner() const {
+    return inner_;
+  }
+  IntIdx GetWidth() const {
+    return width_;
+  }
+  // Offset between neighbours in direction d
+  size_t GetStride(size_t d) const {
+    size_t res = 1;
+    for (size_t i = 0; i < d; ++i) {
+      res *= size_[i];
+    }
+    return res;
+  }
+  size_t GetFlat(MIdx midx) const {
+    midx -= begin_;
+    size_t res = 0;
+    for (size_t d = dim; d != 0; ) {
+      --d;
+      res *= size_[d];
+      res += midx[d];
+    }
+    return res;
+  }
+  T& operator[](MIdx midx) {
+    return data_[GetFlat(midx)];
+  }
+  const T& operator[](MIdx midx) const {
+    return data_[GetFlat(midx)];
+  }
+  T& operator[](size_t flat) {
+    return data_[flat];
+  }
+  const T& operator[](size_t flat) const {
+    return data_[flat];
+  }
+};
+
+// Copies inner cells to fg and sets zero-gradient ghosts.
+// Requires lexicographic numbering.
+template <class T, class Mesh>
+void FillGhostInner(FieldCellGhost<T, Mesh::dim>& fg,
+                    const geom::FieldCell<T>& fc_u,
+                    const Mesh& mesh) {
+  using MIdx = typename Mesh::MIdx;
+  constexpr size_t dim = Mesh::dim;
+  const auto& bc = mesh.GetBlockCells();
+  const MIdx mb = bc.GetBegin(), me = bc.GetEnd();
+  const IntIdx w = fg.GetWidth();
+
+  // Inner cells, copied by rows along x
+  for (auto& line : bc.GetLines(0)) {
+    size_t flat = fg.GetFlat(mb + bc.GetMIdx(line[0]));
+    for (size_t i = 0; i < line.size(); ++i) {
+      fg[flat + i] = fc_u[line[i]];
+    }
+  }
+
+  // Zero-gradient ghosts in each direction
+  for (size_t d = 0; d < dim; ++d) {
+    MIdx size = bc.GetDimensions();
+    size[d] = 1;
+    for (auto midx : geom::BlockCells<dim>(mb, size)) {
+      for (IntIdx k = 1; k <= w; ++k) {
+        MIdx lo = midx, hi = midx;
+        lo[d] = mb[d] - k;
+        hi[d] = me[d] - 1 + k;
+        MIdx lo_in = midx, hi_in = midx;
+        hi_in[d] = me[d] - 1;
+        fg[lo] = fg[lo_in];
+        fg[hi] = fg[hi_in];
+      }
+    }
+  }
+}
+
+// Sets ghosts behind boundary face idxface as odd reflections
+// of inner cells about face value uf.
+// id: index of the valid neighbour cell of idxface
+template <class T, class Mesh>
+void ReflectGhost(FieldCellGhost<T, Mesh::dim>& fg, geom::IdxFace idxface,
+                  size_t id, const T& uf, const Mesh& mesh) {
+  using MIdx = typename Mesh::MIdx;
+  const auto& bc = mesh.GetBlockCells();
+  const MIdx mb = bc.GetBegin(), me = bc.GetEnd();
+  // Outward direction from the valid cell
+  size_t d = mesh.GetDirection(idxface);
+  IntIdx out = (id == 0 ? 1 : -1);
+  MIdx mc = mb + bc.GetMIdx(mesh.GetNeighbourCell(idxface, id));
+  for (IntIdx k = 0; k < fg.GetWidth(); ++k) {
+    MIdx mg = mc, mi = mc;
+    mg[d] += out * (k + 1);
+    mi[d] = std::max(mb[d], std::min(me[d] - 1, mc[d] - out * k));
+    fg[mg] = uf * 2. - fg[mi];
+  }
+}
+
+// Fills fg from cell values and boundary conditions.
+// Ghost cells are odd reflections of inner cells about the face value
+// given by the condition, so the mean of the two cells adjacent
+// to a boundary face equals the face value. Faces without a condition
+// get zero-gradient ghosts. Corner ghosts (outside the block in more
+// than one direction) are not filled, as face stencils do not use them.
+template <class T, class Mesh>
+void FillGhost(FieldCellGhost<T, Mesh::dim>& fg,
+               const geom::FieldCell<T>& fc_u,
+               const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond,
+               const Mesh& mesh) {
+  using Scal = typename Mesh::Scal;
+  using IdxCell = geom::IdxCell;
+  using IdxFace = geom::IdxFace;
+
+  FillGhostInner(fg, fc_u, mesh);
+
+  // Reflection about face values given by conditions
+  for (auto it = mf_cond.cbegin(); it != mf_cond.cend(); ++it) {
+    IdxFace idxface = it->GetIdx();
+    if (mesh.IsInner(idxface)) {
+      continue;
+    }
+    size_t id = mesh.GetValidNeighbourCellId(idxface);
+    IdxCell cc = mesh.GetNeighbourCell(idxface, id);
+    ConditionFace* cond = it->GetValue().get();
+    T uf;
+    if (auto cond_value = dynamic_cast<ConditionFaceValue<T>*>(cond)) {
+      uf = cond_value->GetValue();
+    } else if (auto cond_derivative =
+        dynamic_cast<ConditionFaceDerivative<T>*>(cond)) {
+      Scal factor = (id == 0 ? 1. : -1.);
+      Scal alpha = mesh.GetVectToCell(idxface, id).norm() * factor;
+      uf = fc_u[cc] + cond_derivative->GetDerivative() * alpha;
+    } else if (dynamic_cast<ConditionFaceExtrapolation*>(cond)) {
+      uf = fc_u[cc];
+    } else {
+      throw std::runtime_error("FillGhost: unknown condition type");
+    }
+    ReflectGhost(fg, idxface, id, uf, mesh);
+  }
+}
+
+// Same as above with conditions from a compiled table,
+// face values as in InterpolateBoundary() except for extrapolation
+// which is taken as the value in the adjacent cell.
+template <class T, class Mesh>
+void FillGhost(FieldCellGhost<T, Mesh::dim>& fg,
+               const geom::FieldCell<T>& fc_u,
+               const ConditionFaceTable<T, Mesh>& cond,
+               const Mesh& mesh) {
+  using Scal = typename Mesh::Scal;
+
+  FillGhostInner(fg, fc_u, mesh);
+
+  for (auto& e : cond.GetValues()) {
+    ReflectGhost(fg, e.idxface, e.factor > 0. ? 0 : 1, e.value, mesh);
+  }
+  for (auto& e : cond.GetDerivatives()) {
+    Scal alpha = e.dist * e.factor;
+    ReflectGhost(fg, e.idxface, e.factor > 0. ? 0 : 1,
+                 fc_u[e.idxcell] + e.derivative * alpha, mesh);
+  }
+  for (auto& e : cond.GetExtrapolations()) {
+    ReflectGhost(fg, e.idxface, mesh.GetValidNeighbourCellId(e.idxface),
+                 fc_u[e.idxcell], mesh);
+  }
+}
+
+// Mean of adjacent cells on every face, boundary faces included.
+// Faces are traversed by rows along x which are contiguous both
+// in fg and in the face numbering (requires lexicographic numbering).
+template <class T, class Mesh>
+geom::FieldFace<T> InterpolateGhost(const FieldCellGhost<T, Mesh::dim>& fg,
+                                    const Mesh& mesh) {
+  using MIdx = typename Mesh::MIdx;
+  using Direction = typename Mesh::Direction;
+  constexpr size_t dim = Mesh::dim;
+  const auto& bc = mesh.GetBlockCells();
+  const auto& bf = mesh.GetBlockFaces();
+  const MIdx mb = bc.GetBegin(), me = bc.GetEnd();
+  assert(!geom::IsTile(bc.GetTile()));
+
+  geom::FieldFace<T> res(mesh);
+  for (size_t d = 0; d < dim; ++d) {
+    Direction dir(d);
+    const size_t stride = fg.GetStride(d);
+    MIdx plane = me - mb + dir;
+    const size_t nx = plane[0];
+    plane[0] = 1;
+    for (auto midx : geom::BlockCells<dim>(mb, plane)) {
+      const size_t flat = fg.GetFlat(midx);
+      const size_t raw = bf.GetIdx(midx, dir).GetRaw();
+      for (size_t i = 0; i < nx; ++i) {
+        res[geom::IdxFace(raw + i)] =
+            (fg[flat + i - stride] + fg[flat + i]) * 0.5;
+      }
+    }
+  }
+  return res;
+}
+
+// Gradient by the Gauss theorem with face values as the mean
+// of adjacent cells, ghosts on boundary faces.
+// Matches Gradient() of Interpolate() on inner faces,
+// excluded cells are not supported.
+// Requires lexicographic numbering.
+template <class Mesh>
+void GradientGhost(const FieldCellGhost<typename Mesh::Scal, Mesh::dim>& fg,
+                   const Mesh& mesh,
+                   geom::FieldCell<typename Mesh::Vect>& res) {
+  using Scal = typename Mesh::Scal;
+  using Vect = typename Mesh::Vect;
+  using MIdx = typename Mesh::MIdx;
+  using IdxCell = geom::IdxCell;
+  constexpr size_t dim = Mesh::dim;
+  const auto& bc = mesh.GetBlockCells();
+  const MIdx mb = bc.GetBegin();
+  std::array<size_t, dim> stride;
+  for (size_t d = 0; d < dim; ++d) {
+    stride[d] = fg.GetStride(d);
+  }
+  const bool axisymmetric = mesh.IsAxisymmetric();
+  const auto lines = bc.GetLines(0);
+
+  res.Reinit(mesh);
+#pragma omp parallel for
+  for (IntIdx l = 0; l < IntIdx(lines.size()); ++l) {
+    const auto& line = lines[l];
+    const size_t flat = fg.GetFlat(mb + bc.GetMIdx(line[0]));
+    for (size_t i = 0; i < line.size(); ++i) {
+      IdxCell idxcell = line[i];
+      const size_t c = flat + i;
+      Vect sum = Vect::kZero;
+      Scal mean = 0.;
+      // Neighbour faces ordered as in GetNeighbourFace(): lower, upper
+      for (size_t n = 0; n < 2 * dim; ++n) {
+        const size_t s = stride[n / 2];
+        Scal uf = (n % 2 == 0 ?
+            (fg[c - s] + fg[c]) * 0.5 : (fg[c] + fg[c + s]) * 0.5);
+        sum += mesh.GetOutwardSurface(idxcell, n) * uf;
+        mean += uf;
+      }
+      res[idxcell] = sum / mesh.GetVolume(idxcell);
+      if (axisymmetric) {
+        res[idxcell][0] -= mean / (2 * dim) * mesh.GetHoopFactor(idxcell);
+      }
+    }
+  }
+}
+
+} // namespace solver
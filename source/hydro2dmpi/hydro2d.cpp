@@ -17,6 +17,14 @@ namespace registrators {
 #ifdef MODULE_HYDRO_2D
 ModuleRegistrator<hydro<geom::geom2d::MeshStructured<double>>>
 reg_2d_double({"hydro2D_uniform_MPI", "hydro2d"});
+
+// Geometry computed on the fly (uniform mesh only)
+ModuleRegistrator<hydro<geom::MeshUniform<double, 2>>>
+reg_2d_implicit_double({"hydro2d_implicit_geometry"});
+
+// Single precision fields
+ModuleRegistrator<hydro<geom::geom2d::MeshStructured<float>>>
+reg_2d_float({"hydro2d_float"});
 #endif
 
 } // namespace registrators
@@ -15,6 +15,7 @@
 #include "mesh.hpp"
 #include "mesh2d.hpp"
 #include "mesh3d.hpp"
+#include "mesh_uniform.hpp"
 #include "output.hpp"
 #include "output_tecplot.hpp"
 #include "output_paraview.hpp"
@@ -66,6 +67,8 @@ class hydro : public TModule
   using FieldFace = geom::FieldFace<T>;
   template <class T>
   using FieldNode = geom::FieldNode<T>;
+  template <class T>
+  using FieldCellMulti = geom::FieldCellMulti<T>;
 
   struct Flags {
     bool no_output = false;
@@ -90,8 +93,9 @@ class hydro : public TModule
   // Velocity slip is phase velocity relative to mixture velocity
   std::vector<FieldCell<Vect>> v_fc_velocity_slip;
   std::vector<FieldFace<Scal>> v_ff_volume_flux_slip;
-  std::vector<FieldCell<Scal>> v_fc_volume_fraction;
-  std::vector<FieldCell<Scal>> v_fc_true_density_target, v_fc_true_density;
+  // Values of phases, interleaved in each cell
+  FieldCellMulti<Scal> fcm_volume_fraction;
+  FieldCellMulti<Scal> fcm_true_density_target, fcm_true_density;
 
   std::vector<const FieldFace<Scal>*> v_p_ff_volume_flux_slip;
   FieldCell<Vect> fc_force;
@@ -139,13 +143,12 @@ class hydro : public TModule
   void CalcPhasesMassSource();
 
   FieldCell<Scal> GetVolumeAveraged(const std::vector<Scal>& v_value);
+  FieldCell<Scal> GetVolumeAveraged(const FieldCellMulti<Scal>& fcm_field);
   void AppendAntidiffusionVolumeFlux();
   void CalcRadiation();
   void CalcForce();
   void CalcMixtureVolumeSource();
   template <class T>
-  FieldCell<T> GetVolumeAveraged(const std::vector<FieldCell<T>>& v_fc_field);
-  template <class T>
   FieldCell<T> GetSum(const std::vector<FieldCell<T>>& v_fc_field);
   // Reads matrix from file fn and maps onto box b.
   // Overwrites relevant cells of fc_u.
@@ -247,6 +250,34 @@ hydro<Mesh>::GetLinearSolverFactory(std::string linear_name,
   throw std::runtime_error("Unknown linear solver '" + linear_name + "'");
 }
 
+// Axisymmetric geometry is available for geom2d::MeshStructured only
+template <class Mesh>
+void MakeAxisymmetric(Mesh&) {
+  throw std::runtime_error("axisymmetric: not supported by the mesh");
+}
+
+template <class Scal>
+void MakeAxisymmetric(geom::geom2d::MeshStructured<Scal>& mesh) {
+  mesh.MakeAxisymmetric();
+}
+
+// Fluid solver on overlapping subdomains
+// is available for geom2d::MeshStructured only
+template <class Mesh, class... Args>
+std::shared_ptr<solver::FluidSolver<Mesh>>
+MakeFluidSimpleParallel(const Mesh&, Args&&...) {
+  throw std::runtime_error("num_local_mesh: not supported by the mesh");
+}
+
+template <class Scal, class... Args>
+std::shared_ptr<solver::FluidSolver<geom::geom2d::MeshStructured<Scal>>>
+MakeFluidSimpleParallel(const geom::geom2d::MeshStructured<Scal>& mesh,
+                        Args&&... args) {
+  return std::make_shared<
+      solver::FluidSimpleParallel<geom::geom2d::MeshStructured<Scal>>>(
+          mesh, std::forward<Args>(args)...);
+}
+
 template <class Mesh>
 void hydro<Mesh>::InitMesh() {
   MIdx mesh_size;
@@ -257,11 +288,32 @@ void hydro<Mesh>::InitMesh() {
   domain = geom::Rect<Vect>(GetVect<Vect>(P_vect["A"]),
                             GetVect<Vect>(P_vect["B"]));
 
-  geom::InitUniformMesh(mesh, domain, mesh_size);
+  SingleTimer timer;
+  int memory_kb = sysinfo::physical_usage_kb();
+
+  // Tiled numbering of cells and faces for better cache reuse
+  if (auto* tile = P_int("cell_tile")) {
+    geom::InitUniformMesh(mesh, domain, mesh_size, MIdx(*tile));
+  } else {
+    geom::InitUniformMesh(mesh, domain, mesh_size);
+  }
+
+  // Rotationally symmetric cases on a 2D mesh, x is the radial coordinate
+  if (auto* ptr = P_int("axisymmetric")) {
+    if (*ptr) {
+      MakeAxisymmetric(mesh);
+    }
+  }
 
   meshpos = Vect(0);
 
   P_int.set("cells_number", static_cast<int>(mesh.GetNumCells()));
+  P_double.set("mesh_time", timer.GetSeconds());
+  P_double.set("mesh_memory",
+               (sysinfo::physical_usage_kb() - memory_kb) / 1000.0);
+  logger() << "Mesh: cells=" << mesh.GetNumCells()
+      << ", time=" << P_double["mesh_time"] << "s"
+      << ", mem=" << P_double["mesh_memory"] << "MB";
 }
 
 template <class Mesh>
@@ -423,11 +475,9 @@ void hydro<Mesh>::InitFluidSolver() {
   }
 
   // Checkout for unhandled boundaries
-  for (auto idxface : mesh.Faces()) {
-    if (!mesh.IsInner(idxface) && !mesh.IsExcluded(idxface)) {
-      if (!fluid_cond.find(idxface)) {
-        throw std::runtime_error("Unhandled boundary");
-      }
+  for (auto idxface : mesh.BoundaryFaces()) {
+    if (!fluid_cond.find(idxface)) {
+      throw std::runtime_error("Unhandled boundary");
     }
   }
 
@@ -446,31 +496,53 @@ void hydro<Mesh>::InitFluidSolver() {
          GivenPressureFixed<Mesh>>(value);
   }
 
-  fluid_solver = std::make_shared<solver::FluidSimple<Mesh>>(
-    mesh, fc_velocity_initial, fluid_cond, mc_cond_fluid,
-    P_double["velocity_relaxation_factor"],
-    P_double["pressure_relaxation_factor"],
-    P_double["rhie_chow_factor"],
-    &fc_density_smooth, &fc_viscosity_smooth, 
-    &fc_force, 
-    &fc_stforce, 
-    &ff_stforce,
-    &fc_volume_source, &fc_mass_source,
-    0., dt, *p_linear_factory_velocity, *p_linear_factory_pressure,
-    P_double["convergence_tolerance"], P_int["num_iterations_limit"],
-    &ex->timer_, P_bool["time_second_order"], P_bool["simpler"],
-    P_bool["force_geometric_average"], P_double["guess_extrapolation"],
-    GetVect<Vect>(P_vect["meshvel"]));
-
-  /*fluid_solver = std::make_shared<solver::FluidSimpleParallel<Mesh>>(
+  // Reuse of the assembled momentum operator (disabled by default)
+  size_t momentum_reuse_iters = 0;
+  if (auto* ptr = P_int("momentum_reuse_iters")) {
+    momentum_reuse_iters = *ptr;
+  }
+  double momentum_reuse_flux_threshold = 0.;
+  if (auto* ptr = P_double("momentum_reuse_flux_threshold")) {
+    momentum_reuse_flux_threshold = *ptr;
+  }
+
+  // Subdomains along x solved separately (disabled by default)
+  if (auto* num_local_mesh = P_int("num_local_mesh")) {
+    size_t overlap_width = 2;
+    if (auto* ptr = P_int("overlap_width")) {
+      overlap_width = *ptr;
+    }
+    fluid_solver = MakeFluidSimpleParallel(
+        mesh, fc_velocity_initial, fluid_cond, mc_cond_fluid,
+        P_double["velocity_relaxation_factor"],
+        P_double["pressure_relaxation_factor"],
+        P_double["rhie_chow_factor"],
+        &fc_density_smooth, &fc_viscosity_smooth, &fc_force,
+        &fc_stforce, &ff_stforce,
+        &fc_volume_source, &fc_mass_source,
+        0., dt, *p_linear_factory_velocity, *p_linear_factory_pressure,
+        P_double["convergence_tolerance"], P_int["num_iterations_limit"],
+        &ex->timer_, P_bool["time_second_order"], P_bool["simpler"],
+        P_bool["force_geometric_average"],
+        size_t(*num_local_mesh), overlap_width);
+  } else {
+    fluid_solver = std::make_shared<solver::FluidSimple<Mesh>>(
       mesh, fc_velocity_initial, fluid_cond, mc_cond_fluid,
       P_double["velocity_relaxation_factor"],
       P_double["pressure_relaxation_factor"],
-      &fc_density, &fc_viscosity, &fc_force,
+      P_double["rhie_chow_factor"],
+      &fc_density_smooth, &fc_viscosity_smooth, 
+      &fc_force, 
+      &fc_stforce, 
+      &ff_stforce,
       &fc_volume_source, &fc_mass_source,
-      0., dt, linear_id_velocity, linear_id_pressure,
+      0., dt, *p_linear_factory_velocity, *p_linear_factory_pressure,
       P_double["convergence_tolerance"], P_int["num_iterations_limit"],
-      &ex->timer_, P_int["num_local_mesh"], P_int["overlap_width"]);*/
+      &ex->timer_, P_bool["time_second_order"], P_bool["simpler"],
+      P_bool["force_geometric_average"], P_double["guess_extrapolation"],
+      GetVect<Vect>(P_vect["meshvel"]),
+      momentum_reuse_iters, momentum_reuse_flux_threshold);
+  }
 }
 
 template <class Mesh>
@@ -482,11 +554,17 @@ void hydro<Mesh>::InitAdvectionSolver() {
 
   v_fc_mass_source.resize(num_phases);
   v_ff_volume_flux_slip.resize(num_phases);
-  v_fc_volume_fraction.resize(num_phases);
   v_fc_velocity_slip.resize(num_phases);
   v_p_ff_volume_flux_slip.resize(num_phases);
-  v_fc_true_density_target.resize(num_phases);
-  v_fc_true_density.resize(num_phases);
+  fcm_volume_fraction.Reinit(mesh, num_phases);
+  fcm_true_density_target.Reinit(mesh, num_phases);
+  fcm_true_density.Reinit(mesh, num_phases);
+  for (auto idxcell : mesh.Cells()) {
+    for (auto i : phases) {
+      fcm_true_density_target[idxcell][i] = v_true_density[i];
+      fcm_true_density[idxcell][i] = v_true_density[i];
+    }
+  }
 
   std::vector<FieldCell<Scal>> v_fc_partial_density_initial(num_phases);
 
@@ -494,9 +572,6 @@ void hydro<Mesh>::InitAdvectionSolver() {
     v_fc_mass_source[i].Reinit(mesh, 0.);
     v_fc_velocity_slip[i].Reinit(mesh);
     v_ff_volume_flux_slip[i].Reinit(mesh);
-    v_fc_volume_fraction[i].Reinit(mesh);
-    v_fc_true_density_target[i].Reinit(mesh, v_true_density[i]);
-    v_fc_true_density[i].Reinit(mesh, v_true_density[i]);
     v_fc_partial_density_initial[i].Reinit(
         mesh, v_true_density[i] *
         ecast(P_double("initial_volume_fraction_" + IntToStr(i))));
@@ -505,7 +580,6 @@ void hydro<Mesh>::InitAdvectionSolver() {
 
   // Initial partial density for phases [1, num_phases)
   auto& pd1 = v_fc_partial_density_initial[1];
-  auto& td1 = v_fc_true_density[1];
   // image
   // read table, assume values between 0 and 1
   if (P_string.exist("img_init")) {
@@ -516,7 +590,7 @@ void hydro<Mesh>::InitAdvectionSolver() {
     ReadField(fn, b, tmp);
     for (auto idx : mesh.Cells()) {
       if (b.IsInside(mesh.GetCenter(idx))) {
-        pd1[idx] = tmp[idx] * td1[idx];
+        pd1[idx] = tmp[idx] * fcm_true_density[idx][1];
       }
     }
   }
@@ -533,13 +607,13 @@ void hydro<Mesh>::InitAdvectionSolver() {
   for (auto idx : mesh.Cells()) {
     Vect x = mesh.GetCenter(idx);
     if (block2.IsInside(x)) {
-      v_fc_partial_density_initial[2][idx] = v_fc_true_density[2][idx];
+      v_fc_partial_density_initial[2][idx] = fcm_true_density[idx][2];
     } else if (block1.IsInside(x)) {
-      v_fc_partial_density_initial[1][idx] = v_fc_true_density[1][idx];
+      v_fc_partial_density_initial[1][idx] = fcm_true_density[idx][1];
     } else if (x.dist(IC) < IR) {
-      v_fc_partial_density_initial[1][idx] = v_fc_true_density[1][idx];
+      v_fc_partial_density_initial[1][idx] = fcm_true_density[idx][1];
     } else if (x.dist(IC2) < IR2) {
-      v_fc_partial_density_initial[1][idx] = v_fc_true_density[1][idx];
+      v_fc_partial_density_initial[1][idx] = fcm_true_density[idx][1];
     }
   }
 
@@ -554,10 +628,10 @@ void hydro<Mesh>::InitAdvectionSolver() {
     Scal volume_sum = 0.;
     for (size_t i = 1; i < num_phases; ++i) {
       volume_sum +=
-          v_fc_partial_density_initial[i][idx] / v_fc_true_density[i][idx];
+          v_fc_partial_density_initial[i][idx] / fcm_true_density[idx][i];
     }
     v_fc_partial_density_initial[0][idx] =
-        (1. - volume_sum) * v_fc_true_density[0][idx];
+        (1. - volume_sum) * fcm_true_density[idx][0];
   }
 
   // Boundary conditions for concentration
@@ -786,7 +860,7 @@ void hydro<Mesh>::InitOutput() {
     content_pool.push_back(
         std::make_shared<output::EntryFunction<Scal, IdxCell, Mesh>>(
             "density_" + phase, outmesh, [this, i](IdxCell idx) {
-                return v_fc_true_density[i][out_to_mesh_[idx]]; }));
+                return fcm_true_density[out_to_mesh_[idx]][i]; }));
   }
 
   // Target density output field
@@ -795,7 +869,7 @@ void hydro<Mesh>::InitOutput() {
     content_pool.push_back(
         std::make_shared<output::EntryFunction<Scal, IdxCell, Mesh>>(
             "target_density_" + phase, outmesh, [this, i](IdxCell idx) {
-                return v_fc_true_density_target[i][out_to_mesh_[idx]]; }));
+                return fcm_true_density_target[out_to_mesh_[idx]][i]; }));
   }
 
   // Partial density output field
@@ -813,7 +887,7 @@ void hydro<Mesh>::InitOutput() {
     content_pool.push_back(
         std::make_shared<output::EntryFunction<Scal, IdxCell, Mesh>>(
             "volume_fraction_" + phase, outmesh, [this, i](IdxCell idx) {
-                return v_fc_volume_fraction[i][out_to_mesh_[idx]]; }));
+                return fcm_volume_fraction[out_to_mesh_[idx]][i]; }));
   }
 
   for (auto& entry : content_pool) {
@@ -981,15 +1055,16 @@ template <class Mesh>
 void hydro<Mesh>::CalcPhasesVolumeFraction() {
   // Calc and normalize volume fraction for phases
   for (auto idxcell : mesh.Cells()) {
+    Scal* volume_fraction = fcm_volume_fraction[idxcell];
+    const Scal* true_density = fcm_true_density[idxcell];
     Scal sum = 0.;
     for (auto i : phases) {
-      v_fc_volume_fraction[i][idxcell] =
-          advection_solver->GetField(i)[idxcell] /
-          v_fc_true_density[i][idxcell];
-      sum += v_fc_volume_fraction[i][idxcell];
+      volume_fraction[i] =
+          advection_solver->GetField(i)[idxcell] / true_density[i];
+      sum += volume_fraction[i];
     }
     for (auto i : phases) {
-      v_fc_volume_fraction[i][idxcell] /= sum;
+      volume_fraction[i] /= sum;
     }
 
     //assert(std::abs(sum - 1.) < 1e-3);
@@ -1041,7 +1116,7 @@ void hydro<Mesh>::CalcPhaseVelocitySlip() {
     std::vector<Vect> v_velocity_relative_to_carrier(num_phases, Vect::kZero);
     for (auto i : phases) {
       if (v_enable_settling[i]) {
-        Scal phase_c = v_fc_volume_fraction[i][idxcell];
+        Scal phase_c = fcm_volume_fraction[idxcell][i];
         Scal mixture_density = fc_density[idxcell];
         Scal mixture_viscosity = fc_viscosity_smooth[idxcell];
         Scal phase_density = v_true_density[i];
@@ -1059,7 +1134,7 @@ void hydro<Mesh>::CalcPhaseVelocitySlip() {
       for (auto i : phases) {
         carrier_velocity_relative_to_mixture +=
             v_velocity_relative_to_carrier[i] *
-            v_fc_volume_fraction[i][idxcell];
+            fcm_volume_fraction[idxcell][i];
       }
 
       // Calc phase velocities relative to mixture velocity
@@ -1098,7 +1173,7 @@ void hydro<Mesh>::CalcPhaseVelocitySlip() {
         Scal aver = 0.;
         for (auto i : phases) {
           Scal c = solver::GetInterpolatedInner(
-              v_fc_volume_fraction[i], idxface, mesh);
+              fcm_volume_fraction, i, idxface, mesh);
           aver += c * v_ff_volume_flux_slip[i][idxface];
         }
         for (auto i : phases) {
@@ -1109,11 +1184,11 @@ void hydro<Mesh>::CalcPhaseVelocitySlip() {
   } else {
     // Add carrier volume flux
     for (auto idxcell : mesh.Cells()) {
+      const Scal* true_density = fcm_true_density[idxcell];
       Scal volume_fraction_defect = 1.;
       for (auto i : phases) {
         volume_fraction_defect -=
-            advection_solver->GetField(i)[idxcell] /
-            v_fc_true_density[i][idxcell];
+            advection_solver->GetField(i)[idxcell] / true_density[i];
       }
       fc_volume_source[idxcell] = -volume_fraction_defect /
           fluid_solver->GetTimeStep();
@@ -1127,27 +1202,25 @@ void hydro<Mesh>::CalcPhaseVelocitySlip() {
 template <class Mesh>
 void hydro<Mesh>::CalcPhasesTrueDensity() {
   if (P_bool["compressible_enable"]) {
-    // Calc target density
-    for (auto i : phases) {
-      std::string phase = IntToStr(i);
-      Scal rate = P_double["temperature_expansion_rate_" + phase];
-      Scal base = P_double["temperature_expansion_base_" + phase];
-      for (auto idxcell : mesh.Cells()) {
-        v_fc_true_density_target[i][idxcell] = v_true_density[i]
-            * (1. - rate * (heat_solver->GetTemperature()[idxcell] - base));
-      }
-    }
-    // Calc true density from target density
-    // and normalize the value to preserve correct volume fraction
+    auto v_rate = GetPhaseProperty("temperature_expansion_rate_");
+    auto v_base = GetPhaseProperty("temperature_expansion_base_");
+    const auto& fc_temperature = heat_solver->GetTemperature();
     for (auto idxcell : mesh.Cells()) {
+      Scal* target = fcm_true_density_target[idxcell];
+      Scal* true_density = fcm_true_density[idxcell];
+      // Calc target density
+      for (auto i : phases) {
+        target[i] = v_true_density[i]
+            * (1. - v_rate[i] * (fc_temperature[idxcell] - v_base[i]));
+      }
+      // Calc true density from target density
+      // and normalize the value to preserve correct volume fraction
       Scal alpha = 0.;
       for (auto i : phases) {
-        alpha += advection_solver->GetField(i)[idxcell]
-            / v_fc_true_density_target[i][idxcell];
+        alpha += advection_solver->GetField(i)[idxcell] / target[i];
       }
       for (auto i : phases) {
-        v_fc_true_density[i][idxcell] = v_fc_true_density_target[i][idxcell]
-            * alpha;
+        true_density[i] = target[i] * alpha;
       }
     }
   } else {
@@ -1193,7 +1266,7 @@ void hydro<Mesh>::CalcPhasesMassSource() {
     std::vector<Scal> molar_concentration(num_phases);
     for (auto i : phases) {
       molar_concentration[i] =
-          v_fc_volume_fraction[i][idxcell] *
+          fcm_volume_fraction[idxcell][i] *
           v_true_density[i] / v_molar_mass[i];
     }
 
@@ -1210,7 +1283,7 @@ void hydro<Mesh>::CalcPhasesMassSource() {
 //  for (auto idxcell : mesh.Cells()) {
 //    for (auto i : phases) {
 //      Limit(v_fc_mass_source[i][idxcell],
-//            v_fc_volume_fraction[i][idxcell],
+//            fcm_volume_fraction[idxcell][i],
 //            v_true_density[i], Scal(fluid_solver->GetTimeStep()));
 //    }
 //  }
@@ -1219,43 +1292,22 @@ void hydro<Mesh>::CalcPhasesMassSource() {
 // TODO: Add feature "requre smth" to indicate which fields should be known
 
 template <class Mesh>
-template <class T>
 auto hydro<Mesh>::GetVolumeAveraged(
-    const std::vector<FieldCell<T>>& v_fc_field) -> FieldCell<T> {
-  FieldCell<T> res(mesh, T(0));
-  for (auto i : phases) {
-    for (auto idxcell : mesh.Cells()) {
-      res[idxcell] +=
-          v_fc_field[i][idxcell] * v_fc_volume_fraction[i][idxcell];
-    }
-  }
-  return res;
+    const FieldCellMulti<Scal>& fcm_field) -> FieldCell<Scal> {
+  return geom::Dot(fcm_field, fcm_volume_fraction);
 }
 
 template <class Mesh>
 auto hydro<Mesh>::GetVolumeAveraged(
     const std::vector<Scal>& v_value) -> FieldCell<Scal> {
-  FieldCell<Scal> res(mesh, 0);
-  for (auto i : phases) {
-    for (auto idxcell : mesh.Cells()) {
-      res[idxcell] +=
-          v_value[i] * v_fc_volume_fraction[i][idxcell];
-    }
-  }
-  return res;
+  return geom::Dot(v_value, fcm_volume_fraction);
 }
 
 template <class Mesh>
 template <class T>
 auto hydro<Mesh>::GetSum(
     const std::vector<FieldCell<T>>& v_fc_field) -> FieldCell<T> {
-  FieldCell<T> res(mesh, T(0));
-  for (auto i : phases) {
-    for (auto idxcell : mesh.Cells()) {
-      res[idxcell] += v_fc_field[i][idxcell] ;
-    }
-  }
-  return res;
+  return geom::Sum(v_fc_field, mesh.GetNumCells());
 }
 
 // TODO: Split templates into files
@@ -1271,7 +1323,7 @@ void hydro<Mesh>::AppendAntidiffusionVolumeFlux() {
                               v_mf_partial_density_cond_[i], mesh),
           mesh);
       for (auto idxcell : mesh.Cells()) {
-        Scal c = v_fc_volume_fraction[i][idxcell];
+        Scal c = fcm_volume_fraction[idxcell][i];
         v_fc_antidiffusion[i][idxcell] *= -antidiffusion_factor * c * (1. - c);
       }
     }
@@ -1310,15 +1362,13 @@ void hydro<Mesh>::CalcForce() {
   Vect gravity = GetVect<Vect>(P_vect["gravity"]);
   Vect force = GetVect<Vect>(P_vect["force"]);
   fc_force.Reinit(mesh);
-  for (auto idxcell : mesh.Cells()) {
-    fc_force[idxcell] = gravity * fc_density[idxcell] + force;
-  }
+  fc_force = gravity * fc_density + force;
 
   // surface tension
   fc_stforce.Reinit(mesh, Vect(0));
   ff_stforce.Reinit(mesh, Vect(0));
   if (num_phases >= 2) {
-    auto a = v_fc_volume_fraction[1];
+    auto a = geom::GetComponent(fcm_volume_fraction, 1);
     //auto as = solver::GetSmoothField(a, mesh, 1);
     auto as = a;
 
@@ -1329,11 +1379,9 @@ void hydro<Mesh>::CalcForce() {
     auto gsc = solver::Gradient(asf, mesh);
     // zero-derivative bc for Vect
     geom::MapFace<std::shared_ptr<solver::ConditionFace>> mfvz;
-    for (auto idxface : mesh.Faces()) {
-      if (!mesh.IsExcluded(idxface) && !mesh.IsInner(idxface)) {
-        mfvz[idxface] =
-            std::make_shared<solver::ConditionFaceDerivativeFixed<Vect>>(Vect(0));
-      }
+    for (auto idxface : mesh.BoundaryFaces()) {
+      mfvz[idxface] =
+          std::make_shared<solver::ConditionFaceDerivativeFixed<Vect>>(Vect(0));
     }
     // surface tension on faces
     auto sigma = P_double["sigma"];
@@ -1371,27 +1419,28 @@ void hydro<Mesh>::CalcForce() {
     }
   }
 
-  fc_force = solver::GetSmoothField(fc_force, mesh,
-                                    P_int["force_smooth_times"]);
+  solver::GetSmoothField(fc_force, mesh, fc_force,
+                         P_int["force_smooth_times"]);
 }
 
 template<class Mesh>
 void hydro<Mesh>::CalcMixtureVolumeSource() {
   fc_volume_source.Reinit(mesh, 0.);
   for (auto idxcell : mesh.Cells()) {
+    const Scal* true_density = fcm_true_density[idxcell];
     for (auto i : phases) {
       fc_volume_source[idxcell] += v_fc_mass_source[i][idxcell]
-          / v_fc_true_density[i][idxcell];
+          / true_density[i];
     }
   }
   if (P_bool["compressible_enable"]) {
     // Correct the volume source to account for target density
     Scal compressible_relaxation = P_double["compressible_relaxation"];
     for (auto idxcell : mesh.Cells()) {
+      const Scal* target = fcm_true_density_target[idxcell];
       Scal alpha = 0.;
       for (auto i : phases) {
-        alpha += advection_solver->GetField(i)[idxcell]
-            / v_fc_true_density_target[i][idxcell];
+        alpha += advection_solver->GetField(i)[idxcell] / target[i];
       }
       fc_volume_source[idxcell] += (alpha - 1.) / fluid_solver->GetTimeStep()
           * compressible_relaxation;
@@ -1407,9 +1456,9 @@ void hydro<Mesh>::UpdateFluidProperties() {
   CalcPhasesVolumeFraction();
   CalcPhasesMassSource();
 
-  fc_density = GetVolumeAveraged(v_fc_true_density);
-  fc_density_smooth = solver::GetSmoothField(
-      fc_density, mesh, P_int["density_smooth_times"]);
+  fc_density = GetVolumeAveraged(fcm_true_density);
+  solver::GetSmoothField(
+      fc_density, mesh, fc_density_smooth, P_int["density_smooth_times"]);
 
   fc_viscosity_smooth = solver::GetSmoothField(
       GetVolumeAveraged(v_viscosity), mesh, P_int["viscosity_smooth_times"]);
@@ -1433,13 +1482,13 @@ template <class Mesh>
 void hydro<Mesh>::CalcStat() {
   for (auto i : phases) {
     Scal density = v_true_density[i];
-    Scal volume = 0.;
+    geom::FieldAccumType<Scal> volume = 0.;
     Scal pd_min = 1e10;
     Scal pd_max = -1e10;
     Vect center(0);
     Vect vel(0);
     for (auto idxcell : mesh.Cells()) {
-      Scal c = v_fc_volume_fraction[i][idxcell];
+      Scal c = fcm_volume_fraction[idxcell][i];
       volume += c * mesh.GetVolume(idxcell);
       auto pd = advection_solver->GetField(i)[idxcell];
       pd_min = std::min(pd_min, pd);
@@ -1470,8 +1519,8 @@ void hydro<Mesh>::CalcStat() {
       P_double.set("stat_vz_" + IntToStr(i), vel[2]);
     }
 
-    Scal volume_flux_in = 0.;
-    Scal volume_flux_out = 0.;
+    geom::FieldAccumType<Scal> volume_flux_in = 0.;
+    geom::FieldAccumType<Scal> volume_flux_out = 0.;
     for (auto idxface : mesh.Faces()) {
       if (!mesh.IsInner(idxface)) {
         auto cellid = mesh.GetValidNeighbourCellId(idxface);
@@ -1479,7 +1528,7 @@ void hydro<Mesh>::CalcStat() {
         Scal factor = (cellid == 1 ? 1. : -1.);
         Scal flux = fluid_solver->GetVolumeFlux()[idxface];
         Scal flux_to_cell = flux * factor;
-        Scal volume_fraction = v_fc_volume_fraction[i][idxcell];
+        Scal volume_fraction = fcm_volume_fraction[idxcell][i];
         if (flux_to_cell >=0 ) {
           volume_flux_in += flux_to_cell * volume_fraction;
         } else {
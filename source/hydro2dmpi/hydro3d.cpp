@@ -17,6 +17,14 @@ namespace registrators {
 #ifdef MODULE_HYDRO_3D
 ModuleRegistrator<hydro<geom::geom3d::MeshStructured<double>>>
 reg_3d_double({"hydro3D_uniform_MPI", "hydro3d"});
+
+// Geometry computed on the fly (uniform mesh only)
+ModuleRegistrator<hydro<geom::MeshUniform<double, 3>>>
+reg_3d_implicit_double({"hydro3d_implicit_geometry"});
+
+// Single precision fields
+ModuleRegistrator<hydro<geom::geom3d::MeshStructured<float>>>
+reg_3d_float({"hydro3d_float"});
 #endif
 
 } // namespace registrators
@@ -142,7 +142,16 @@ class Expression {
   }
   void SortTerms(bool force = false) {
     if (!sorted_ || force) {
-      std::sort(terms_.begin(), terms_.begin() + size_);
+      // Insertion sort, stable and linear if already nearly sorted
+      for (size_t i = 1; i < size_; ++i) {
+        TermType term = terms_[i];
+        size_t j = i;
+        while (j > 0 && term < terms_[j - 1]) {
+          terms_[j] = terms_[j - 1];
+          --j;
+        }
+        terms_[j] = term;
+      }
       sorted_ = true;
     }
   }
@@ -309,6 +318,92 @@ class LinearSolver {
   virtual ~LinearSolver() {}
 };
 
+// Compact numbering of active unknowns (e.g. cells not excluded
+// from the mesh) to solve systems without rows of inactive unknowns.
+template <class Idx>
+class CompactNumbering {
+  template <class T>
+  using Field = geom::FieldGeneric<T, Idx>;
+  std::vector<Idx> full_; // full index of each compact index
+  std::vector<Idx> compact_; // compact index of each full index or None
+
+ public:
+  CompactNumbering() {}
+  // num: number of unknowns
+  // active: range of active indices in increasing order
+  template <class Active>
+  CompactNumbering(size_t num, const Active& active)
+      : compact_(num, Idx::None())
+  {
+    for (auto idx : active) {
+      compact_[idx.GetRaw()] = Idx(full_.size());
+      full_.push_back(idx);
+    }
+  }
+  // True if all unknowns are active
+  bool IsIdentity() const {
+    return full_.size() == compact_.size();
+  }
+  size_t size() const {
+    return full_.size();
+  }
+  bool IsActive(Idx idx) const {
+    return !compact_[idx.GetRaw()].IsNone();
+  }
+  // Rows of active unknowns with terms renumbered.
+  // Terms of inactive unknowns are dropped.
+  template <class Expr>
+  Field<Expr> Compact(const Field<Expr>& system) const {
+    Field<Expr> res(geom::Range<Idx>(0, full_.size()));
+#pragma omp parallel for
+    for (geom::IntIdx i = 0; i < geom::IntIdx(full_.size()); ++i) {
+      const Expr& eqn = system[full_[i]];
+      Expr& out = res[Idx(i)];
+      for (size_t k = 0; k < eqn.size(); ++k) {
+        Idx idx = compact_[eqn[k].idx.GetRaw()];
+        if (!idx.IsNone()) {
+          out.InsertTerm(eqn[k].coeff, idx);
+        }
+      }
+      out.SetConstant(eqn.GetConstant());
+    }
+    return res;
+  }
+  // Field of all unknowns from field of active unknowns,
+  // inactive unknowns set to value
+  template <class T>
+  Field<T> Expand(const Field<T>& field, const T& value) const {
+    Field<T> res(geom::Range<Idx>(0, compact_.size()), value);
+#pragma omp parallel for
+    for (geom::IntIdx i = 0; i < geom::IntIdx(full_.size()); ++i) {
+      res[full_[i]] = field[Idx(i)];
+    }
+    return res;
+  }
+};
+
+// Solves the system for active unknowns. Rows of inactive unknowns
+// must be diagonal (e.g. identity), they are solved separately.
+template <class Scal, class Idx, class Expr>
+geom::FieldGeneric<Scal, Idx> Solve(
+    LinearSolver<Scal, Idx, Expr>& linear,
+    const geom::FieldGeneric<Expr, Idx>& system,
+    const CompactNumbering<Idx>& numbering) {
+  if (numbering.IsIdentity()) {
+    return linear.Solve(system);
+  }
+  auto res = numbering.Expand(
+      linear.Solve(numbering.Compact(system)), Scal(0));
+  for (auto idx : system.GetRange()) {
+    if (!numbering.IsActive(idx)) {
+      const Expr& eqn = system[idx];
+      assert(eqn.size() == 1 && eqn[0].idx == idx);
+      res[idx] = -eqn.GetConstant() / eqn[0].coeff;
+    }
+  }
+  return res;
+}
+
 class LinearSolverFactoryGeneric {
  public:
   virtual ~LinearSolverFactoryGeneric() {}
@@ -535,7 +630,7 @@ class LuDecomposition : public LinearSolver<Scal, Idx, Expr> {
 
     // forward step
     for(size_t i = 0; i < system.size(); ++i) {
-      Scal sum = 0;
+      geom::FieldAccumType<Scal> sum = 0;
       const auto &expr = system[Idx(i)];
       size_t k = 0;
       while (k < expr.size() && expr[k].idx.GetRaw() < i) {
@@ -550,15 +645,16 @@ class LuDecomposition : public LinearSolver<Scal, Idx, Expr> {
     // backward step
     for (size_t i = system.size(); i > 0; ) {
       --i;
-      Scal sum = 0;
+      geom::FieldAccumType<Scal> sum = 0;
       const auto &expr = system[Idx(i)];
-      size_t k = expr.size() - 1;
-      while (k >= 0 && expr[k].idx.GetRaw() > i) {
-        sum += expr[k].coeff * res[expr[k].idx];
+      // k: number of terms not yet visited
+      size_t k = expr.size();
+      while (k > 0 && expr[k - 1].idx.GetRaw() > i) {
         --k;
+        sum += expr[k].coeff * res[expr[k].idx];
       }
-      assert(k >= 0 && expr[k].idx.GetRaw() == i);
-      Scal coeff_diag = expr[k].coeff;
+      assert(k > 0 && expr[k - 1].idx.GetRaw() == i);
+      Scal coeff_diag = expr[k - 1].coeff;
       res[Idx(i)] -= sum / coeff_diag;
     }
 
@@ -607,7 +703,7 @@ class LuDecompositionRelaxed : public LinearSolver<Scal, Idx, Expr> {
       for(size_t i = 0; i < system.size(); ++i) {
         Idx idx(i);
         const auto &expr = system[idx];
-        Scal sum = 0;
+        geom::FieldAccumType<Scal> sum = 0;
         size_t k = 0;
         while (k < expr.size() && expr[k].idx.GetRaw() < i) {
           sum += expr[k].coeff * corr[expr[k].idx];
@@ -624,14 +720,15 @@ class LuDecompositionRelaxed : public LinearSolver<Scal, Idx, Expr> {
         --i;
         Idx idx(i);
         const auto &expr = system[idx];
-        Scal sum = 0;
-        size_t k = expr.size() - 1;
-        while (k >= 0 && expr[k].idx.GetRaw() > i) {
-          sum += expr[k].coeff * res[expr[k].idx];
+        geom::FieldAccumType<Scal> sum = 0;
+        // k: number of terms not yet visited
+        size_t k = expr.size();
+        while (k > 0 && expr[k - 1].idx.GetRaw() > i) {
           --k;
+          sum += expr[k].coeff * res[expr[k].idx];
         }
-        assert(k >= 0 && expr[k].idx.GetRaw() == i);
-        Scal coeff_diag = expr[k].coeff + relaxation_factor_;
+        assert(k > 0 && expr[k - 1].idx.GetRaw() == i);
+        Scal coeff_diag = expr[k - 1].coeff + relaxation_factor_;
         corr[idx] -= sum / coeff_diag;
       }
 
@@ -692,7 +789,7 @@ class GaussSeidel : public LinearSolver<Scal, Idx, Expr> {
       for (size_t raw = 0; raw < system.size(); ++raw) {
         Idx idx(raw);
         const Expr& eqn = system[idx];
-        Scal sum = 0.;
+        geom::FieldAccumType<Scal> sum = 0.;
         Scal diag_coeff = 0.;
         for (size_t i = 0; i < eqn.size(); ++i) {
           const auto& term = eqn[i];
@@ -758,7 +855,7 @@ class Jacobi : public LinearSolver<Scal, Idx, Expr> {
       for (size_t raw = 0; raw < system.size(); ++raw) {
         Idx idx(raw);
         const Expr& eqn = system[idx];
-        Scal sum = 0.;
+        geom::FieldAccumType<Scal> sum = 0.;
         Scal diag_coeff = 0.;
         for (size_t i = 0; i < eqn.size(); ++i) {
           const auto& term = eqn[i];
@@ -8,12 +8,27 @@
 #pragma once
 
 #include "../common/vect.hpp"
+#include "field_expr.hpp"
 #include <vector>
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
 #include <map>
+#include <memory>
 #include <cassert>
+#include <stdexcept>
 #include <iostream>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#if defined(HUGEPAGES) && defined(__linux__)
+#include <sys/mman.h>
+#endif
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
 namespace geom {
 
@@ -22,15 +37,24 @@ using IntIdx = std::ptrdiff_t;
 template <size_t dim>
 using MIdxGeneral = Vect<IntIdx, dim>;
 
+// Storage type for indices of cells, faces and nodes.
+// Build with IDX32 to halve the memory of connectivity fields
+// (limits the number of elements to 2^32-1).
+#ifdef IDX32
+using IdxRaw = std::uint32_t;
+#else
+using IdxRaw = size_t;
+#endif
+
 template <int dummy>
 class IdxGeneric {
   static constexpr int dummy_ = dummy; // make distinct classes
-  size_t raw_;
-  static constexpr size_t kNone = -1;
+  IdxRaw raw_;
+  static constexpr IdxRaw kNone = -1;
  public:
   IdxGeneric() {}
   explicit IdxGeneric(size_t raw)
-      : raw_(raw)
+      : raw_(static_cast<IdxRaw>(raw))
   {}
   inline size_t GetRaw() const {
     return raw_;
@@ -45,7 +69,7 @@ class IdxGeneric {
     return !(*this == other);
   }
   inline static IdxGeneric None() {
-    return IdxGeneric(-1);
+    return IdxGeneric(kNone);
   }
   inline bool IsNone() const {
     return *this == None();
@@ -104,43 +128,357 @@ class Range {
   size_t size() const {
     return pos_end_ - pos_begin_;
   }
+  size_t GetBegin() const {
+    return pos_begin_;
+  }
+  size_t GetEnd() const {
+    return pos_end_;
+  }
+};
+
+// Union of disjoint contiguous ranges (runs) in increasing order.
+// Kernels may loop over GetRuns() to get branch-free inner loops.
+template <class IdxType>
+class RangeList {
+  std::vector<Range<IdxType>> runs_;
+  size_t size_;
+
+ public:
+  class iterator {
+    const std::vector<Range<IdxType>>* runs_;
+    size_t run_;
+    size_t pos_;
+   public:
+    iterator(const std::vector<Range<IdxType>>* runs, size_t run)
+        : runs_(runs)
+        , run_(run)
+        , pos_(run < runs->size() ? (*runs)[run].GetBegin() : 0)
+    {}
+    iterator& operator++() {
+      if (++pos_ == (*runs_)[run_].GetEnd()) {
+        ++run_;
+        pos_ = (run_ < runs_->size() ? (*runs_)[run_].GetBegin() : 0);
+      }
+      return *this;
+    }
+    bool operator==(const iterator& other) const {
+      return run_ == other.run_ && pos_ == other.pos_;
+    }
+    bool operator!=(const iterator& other) const {
+      return !(*this == other);
+    }
+    IdxType operator*() const {
+      return IdxType(pos_);
+    }
+  };
+
+  RangeList()
+      : size_(0)
+  {}
+  // Maximal runs of indices in [0, num) satisfying pred(IdxType)
+  template <class Pred>
+  RangeList(size_t num, Pred pred)
+      : size_(0)
+  {
+    size_t i = 0;
+    while (i < num) {
+      if (pred(IdxType(i))) {
+        size_t b = i;
+        while (i < num && pred(IdxType(i))) {
+          ++i;
+        }
+        runs_.emplace_back(b, i);
+        size_ += i - b;
+      } else {
+        ++i;
+      }
+    }
+  }
+  iterator begin() const {
+    return iterator(&runs_, 0);
+  }
+  iterator end() const {
+    return iterator(&runs_, runs_.size());
+  }
+  size_t size() const {
+    return size_;
+  }
+  const std::vector<Range<IdxType>>& GetRuns() const {
+    return runs_;
+  }
+};
+
+// Indices begin, begin + stride, ... (count elements), e.g. a grid line
+template <class IdxType>
+class StridedRange {
+  size_t begin_, stride_, count_;
+
+ public:
+  class iterator {
+    size_t pos_, stride_;
+   public:
+    iterator(size_t pos, size_t stride)
+        : pos_(pos)
+        , stride_(stride)
+    {}
+    iterator& operator++() {
+      pos_ += stride_;
+      return *this;
+    }
+    bool operator==(const iterator& other) const {
+      return pos_ == other.pos_;
+    }
+    bool operator!=(const iterator& other) const {
+      return !(*this == other);
+    }
+    IdxType operator*() const {
+      return IdxType(pos_);
+    }
+  };
+
+  StridedRange()
+      : begin_(0)
+      , stride_(1)
+      , count_(0)
+  {}
+  StridedRange(size_t begin, size_t stride, size_t count)
+      : begin_(begin)
+      , stride_(stride)
+      , count_(count)
+  {}
+  iterator begin() const {
+    return iterator(begin_, stride_);
+  }
+  iterator end() const {
+    return iterator(begin_ + stride_ * count_, stride_);
+  }
+  size_t size() const {
+    return count_;
+  }
+  size_t GetStride() const {
+    return stride_;
+  }
+  IdxType operator[](size_t i) const {
+    return IdxType(begin_ + stride_ * i);
+  }
 };
 
+// Allocator of field storage aligned to cache lines.
+// Build with HUGEPAGES to back large blocks by transparent huge pages
+// (Linux only). Elements constructed without arguments are
+// default-initialized, so scalars are left untouched and the owner
+// can initialize them in parallel (see FieldGeneric).
+template <class T>
+class FieldAllocator {
+ public:
+  using value_type = T;
+  static constexpr size_t kAlign = 64;
+  static constexpr size_t kHugeAlign = 2 << 20;
 
+  FieldAllocator() {}
+  template <class U>
+  FieldAllocator(const FieldAllocator<U>&) {}
+  T* allocate(size_t n) {
+    const size_t bytes = std::max<size_t>(n * sizeof(T), 1);
+    size_t align = kAlign;
+#if defined(HUGEPAGES) && defined(__linux__)
+    if (bytes >= kHugeAlign) {
+      align = kHugeAlign;
+    }
+#endif
+    void* p = nullptr;
+#ifdef _WIN32
+    p = _aligned_malloc(bytes, align);
+#else
+    if (posix_memalign(&p, align, bytes) != 0) {
+      p = nullptr;
+    }
+#endif
+    if (!p) {
+      throw std::bad_alloc();
+    }
+#if defined(HUGEPAGES) && defined(__linux__)
+    if (align == kHugeAlign) {
+      madvise(p, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    return static_cast<T*>(p);
+  }
+  void deallocate(T* p, size_t) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+  }
+  template <class U>
+  void construct(U* p) {
+    ::new (static_cast<void*>(p)) U;
+  }
+  template <class U, class... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+  template <class U>
+  bool operator==(const FieldAllocator<U>&) const {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const FieldAllocator<U>&) const {
+    return false;
+  }
+};
+
+// Field of values of type T indexed by Idx.
+// Storage is initialized in parallel loops with the static schedule
+// used by kernels, so that pages are first touched (and placed
+// in memory of the NUMA node) by the threads that later process them.
 template <class T, class Idx>
-class FieldGeneric {
-  using Vector = std::vector<T>;
-  std::vector<T> data_;
+class FieldGeneric : public FieldExpr<FieldGeneric<T, Idx>, Idx> {
+  using Vector = std::vector<T, FieldAllocator<T>>;
+  Vector data_;
   template <class OtherT, class OtherIdx>
   friend class FieldGeneric;
 
+  // std::vector<bool> packs bits, parallel writes would race
+  using Parallel = std::integral_constant<bool, !std::is_same<T, bool>::value>;
+
+  // Sets size to n leaving the elements uninitialized if reallocated
+  // (only for Parallel) and returns pointer to storage
+  T* Allocate(size_t n) {
+    if (n > data_.capacity()) {
+      Vector().swap(data_);
+    }
+    data_.resize(n);
+    return data_.data();
+  }
+  // Resizes to n, new elements value-initialized
+  void Resize(size_t n, std::false_type) {
+    data_.resize(n);
+  }
+  void Resize(size_t n, std::true_type) {
+    const size_t m = std::min(n, data_.size());
+    if (n > data_.capacity()) {
+      Vector data;
+      data.resize(n);
+      T* d = data.data();
+      const T* s = data_.data();
+#pragma omp parallel for schedule(static)
+      for (IntIdx i = 0; i < static_cast<IntIdx>(n); ++i) {
+        d[i] = (static_cast<size_t>(i) < m ? s[i] : T());
+      }
+      data_.swap(data);
+    } else {
+      data_.resize(n);
+      T* d = data_.data();
+#pragma omp parallel for schedule(static)
+      for (IntIdx i = m; i < static_cast<IntIdx>(n); ++i) {
+        d[i] = T();
+      }
+    }
+  }
+  // Resizes to n with all elements equal to value
+  void Assign(size_t n, const T& value, std::false_type) {
+    data_.assign(n, value);
+  }
+  void Assign(size_t n, const T& value, std::true_type) {
+    T* d = Allocate(n);
+#pragma omp parallel for schedule(static)
+    for (IntIdx i = 0; i < static_cast<IntIdx>(n); ++i) {
+      d[i] = value;
+    }
+  }
+  // Copies elements of other
+  void Copy(const FieldGeneric& other, std::false_type) {
+    data_ = other.data_;
+  }
+  void Copy(const FieldGeneric& other, std::true_type) {
+    const size_t n = other.size();
+    T* d = Allocate(n);
+    const T* s = other.data_.data();
+#pragma omp parallel for schedule(static)
+    for (IntIdx i = 0; i < static_cast<IntIdx>(n); ++i) {
+      d[i] = s[i];
+    }
+  }
+
+  // Evaluates expr into data_ (may refer to this field)
+  template <class E, class Op>
+  void Evaluate(const FieldExpr<E, Idx>& expr, Op op) {
+    static_assert(Parallel::value,
+                  "FieldGeneric<bool> cannot be assigned an expression");
+    const E& e = expr.Self();
+    Resize(e.size(), Parallel());
+    T* d = data_.data();
+#pragma omp parallel for schedule(static)
+    for (IntIdx i = 0; i < static_cast<IntIdx>(e.size()); ++i) {
+      op(d[i], e.Eval(i));
+    }
+  }
+
  public:
   using IdxType = Idx;
   using ValueType = T;
+  using ExprRef = const FieldGeneric&;
   FieldGeneric() {}
   template <class U>
   FieldGeneric(const FieldGeneric<U, Idx>& other)
       : data_(other.data_.begin(), other.data_.end()) {}
-  explicit FieldGeneric(const Range<Idx>& range)
-      : data_(range.size())
-  {}
-  FieldGeneric(const Range<Idx>& range, const T& value)
-      : data_(range.size(), value)
-  {}
+  template <class E>
+  FieldGeneric(const FieldExpr<E, Idx>& expr) {
+    *this = expr;
+  }
+  FieldGeneric(const FieldGeneric& other) {
+    Copy(other, Parallel());
+  }
+  FieldGeneric(FieldGeneric&&) = default;
+  FieldGeneric& operator=(const FieldGeneric& other) {
+    if (this != &other) {
+      Copy(other, Parallel());
+    }
+    return *this;
+  }
+  FieldGeneric& operator=(FieldGeneric&&) = default;
+  // Evaluates expression in one loop over elements
+  template <class E>
+  FieldGeneric& operator=(const FieldExpr<E, Idx>& expr) {
+    Evaluate(expr, [](T& a, const FieldExprValue<E>& b) { a = b; });
+    return *this;
+  }
+  template <class E>
+  FieldGeneric& operator+=(const FieldExpr<E, Idx>& expr) {
+    Evaluate(expr, [](T& a, const FieldExprValue<E>& b) { a += b; });
+    return *this;
+  }
+  template <class E>
+  FieldGeneric& operator-=(const FieldExpr<E, Idx>& expr) {
+    Evaluate(expr, [](T& a, const FieldExprValue<E>& b) { a -= b; });
+    return *this;
+  }
+  // Value for bool (std::vector<bool> packs bits), reference otherwise
+  typename Vector::const_reference Eval(size_t i) const {
+    return data_[i];
+  }
+  explicit FieldGeneric(const Range<Idx>& range) {
+    Resize(range.size(), Parallel());
+  }
+  FieldGeneric(const Range<Idx>& range, const T& value) {
+    Assign(range.size(), value, Parallel());
+  }
   size_t size() const {
     return data_.size();
   }
   void Reinit(const Range<Idx>& range) {
-    data_.resize(range.size());
+    Resize(range.size(), Parallel());
   }
   void Reinit(const Range<Idx>& range, const T& value) {
-    data_.assign(range.size(), value);
+    Assign(range.size(), value, Parallel());
   }
   Range<IdxType> GetRange() const {
     return Range<IdxType>(0, size());
   }
   void resize(size_t size) {
-    data_.resize(size);
+    Resize(size, Parallel());
   }
   bool empty() const {
     return data_.empty();
@@ -178,6 +516,15 @@ GetComponent(const FieldGeneric<T, Idx>& f_vect, size_t n) {
   return f_scal;
 }
 
+template <class T, class Idx>
+void GetComponent(const FieldGeneric<T, Idx>& f_vect, size_t n,
+                  FieldGeneric<typename T::value_type, Idx>& f_scal) {
+  f_scal.Reinit(f_vect.GetRange());
+  for (auto idx : f_vect.GetRange()) {
+    f_scal[idx] = f_vect[idx][n];
+  }
+}
+
 template <class T, class Idx>
 void SetComponent(
     FieldGeneric<T, Idx>& f_vect,
@@ -204,44 +551,379 @@ using FieldFace = FieldGeneric<T, IdxFace>;
 template <class T>
 using FieldNode = FieldGeneric<T, IdxNode>;
 
+// Temporary field taken from a pool of released fields
+// with the same element type and index type, preferably of the same size.
+// Returned to the pool on destruction, so that repeated temporaries
+// (e.g. one per iteration) reuse memory instead of allocating it.
+// Pools are per thread, buffers must be released by the same thread.
+template <class T, class Idx>
+class FieldBuffer {
+  using Field = FieldGeneric<T, Idx>;
+  using Pool = std::vector<std::unique_ptr<Field>>;
+  // Maximum number of released fields kept in a pool
+  static constexpr size_t kMaxPool = 32;
+  std::unique_ptr<Field> field_;
+
+  static Pool& GetPool() {
+    static thread_local Pool pool;
+    return pool;
+  }
+
+ public:
+  // Uninitialized field of size range.size()
+  explicit FieldBuffer(const Range<Idx>& range) {
+    Pool& pool = GetPool();
+    auto it = std::find_if(
+        pool.begin(), pool.end(),
+        [&range](const std::unique_ptr<Field>& f) {
+          return f->size() == range.size();
+        });
+    if (it == pool.end() && !pool.empty()) {
+      it = pool.end() - 1;
+    }
+    if (it != pool.end()) {
+      field_ = std::move(*it);
+      pool.erase(it);
+      field_->Reinit(range);
+    } else {
+      field_.reset(new Field(range));
+    }
+  }
+  FieldBuffer(const Range<Idx>& range, const T& value)
+      : FieldBuffer(range)
+  {
+    field_->Reinit(range, value);
+  }
+  FieldBuffer(const FieldBuffer&) = delete;
+  FieldBuffer& operator=(const FieldBuffer&) = delete;
+  ~FieldBuffer() {
+    Pool& pool = GetPool();
+    if (pool.size() < kMaxPool) {
+      pool.push_back(std::move(field_));
+    }
+  }
+  Field& Get() {
+    return *field_;
+  }
+  const Field& Get() const {
+    return *field_;
+  }
+  Field& operator*() {
+    return *field_;
+  }
+  const Field& operator*() const {
+    return *field_;
+  }
+  Field* operator->() {
+    return field_.get();
+  }
+  const Field* operator->() const {
+    return field_.get();
+  }
+  // Number of released fields in the pool of the calling thread
+  static size_t GetPoolSize() {
+    return GetPool().size();
+  }
+};
+
+template <class T>
+using FieldCellBuffer = FieldBuffer<T, IdxCell>;
+
+template <class T>
+using FieldFaceBuffer = FieldBuffer<T, IdxFace>;
+
+template <class T>
+using FieldNodeBuffer = FieldBuffer<T, IdxNode>;
+
+// Vector field stored as dim scalar fields (structure of arrays).
+// Components are scalar fields accessed without copying.
+template <class Vect, class Idx>
+class FieldSoA : public FieldExpr<FieldSoA<Vect, Idx>, Idx> {
+ public:
+  using Scal = typename Vect::value_type;
+  static constexpr size_t dim = Vect::dim;
+  using Component = FieldGeneric<Scal, Idx>;
+
+ private:
+  std::array<Component, dim> comp_;
+
+ public:
+  using IdxType = Idx;
+  using ValueType = Vect;
+  using ExprRef = const FieldSoA&;
+  FieldSoA() {}
+  explicit FieldSoA(const Range<Idx>& range) {
+    Reinit(range);
+  }
+  FieldSoA(const Range<Idx>& range, const Vect& value) {
+    Reinit(range, value);
+  }
+  void Reinit(const Range<Idx>& range) {
+    for (auto& c : comp_) {
+      c.Reinit(range);
+    }
+  }
+  void Reinit(const Range<Idx>& range, const Vect& value) {
+    for (size_t n = 0; n < dim; ++n) {
+      comp_[n].Reinit(range, value[n]);
+    }
+  }
+  size_t size() const {
+    return comp_[0].size();
+  }
+  // Component n
+  Component& operator[](size_t n) {
+    return comp_[n];
+  }
+  const Component& operator[](size_t n) const {
+    return comp_[n];
+  }
+  Vect Get(const Idx& idx) const {
+    return Eval(idx.GetRaw());
+  }
+  void Set(const Idx& idx, const Vect& value) {
+    for (size_t n = 0; n < dim; ++n) {
+      comp_[n][idx] = value[n];
+    }
+  }
+  Vect Eval(size_t i) const {
+    Vect res;
+    for (size_t n = 0; n < dim; ++n) {
+      res[n] = comp_[n].Eval(i);
+    }
+    return res;
+  }
+  // Scatters vector expression (e.g. array of Vect) in one pass
+  template <class E>
+  FieldSoA& operator=(const FieldExpr<E, Idx>& expr) {
+    const E& e = expr.Self();
+    std::array<Scal*, dim> d;
+    for (size_t n = 0; n < dim; ++n) {
+      comp_[n].resize(e.size());
+      d[n] = comp_[n].data();
+    }
+#pragma omp parallel for schedule(static)
+    for (IntIdx i = 0; i < static_cast<IntIdx>(e.size()); ++i) {
+      const Vect v = e.Eval(i);
+      for (size_t n = 0; n < dim; ++n) {
+        d[n][i] = v[n];
+      }
+    }
+    return *this;
+  }
+};
+
+template <class Vect>
+using FieldCellSoA = FieldSoA<Vect, IdxCell>;
+
+template <class Vect>
+using FieldFaceSoA = FieldSoA<Vect, IdxFace>;
+
+// Field with several components per index (e.g. values of phases)
+// stored interleaved: components of one index are contiguous,
+// so that a reduction over components reads one stream.
+// Number of components is N if N > 0 (known at compile time),
+// otherwise set by Reinit().
+template <class T, class Idx, size_t N = 0>
+class FieldMulti {
+  using Vector = std::vector<T, FieldAllocator<T>>;
+  Vector data_;
+  size_t size_ = 0;
+  size_t num_ = N;
+
+ public:
+  using IdxType = Idx;
+  using ValueType = T;
+  FieldMulti() {}
+  FieldMulti(const Range<Idx>& range, size_t num, const T& value = T()) {
+    Reinit(range, num, value);
+  }
+  void Reinit(const Range<Idx>& range, size_t num, const T& value = T()) {
+    if (N > 0 && num != N) {
+      throw std::runtime_error("FieldMulti: number of components != N");
+    }
+    size_ = range.size();
+    num_ = num;
+    const size_t n = size_ * num_;
+    if (n > data_.capacity()) {
+      Vector().swap(data_);
+    }
+    data_.resize(n);
+    T* d = data_.data();
+#pragma omp parallel for schedule(static)
+    for (IntIdx i = 0; i < static_cast<IntIdx>(n); ++i) {
+      d[i] = value;
+    }
+  }
+  size_t size() const {
+    return size_;
+  }
+  // Number of components
+  size_t GetNum() const {
+    return N > 0 ? N : num_;
+  }
+  Range<IdxType> GetRange() const {
+    return Range<IdxType>(0, size());
+  }
+  // Components at index idx
+  T* operator[](const Idx& idx) {
+#ifdef __RANGE_CHECK
+    assert(idx.GetRaw() >= 0 && idx.GetRaw() < size_);
+#endif
+    return data_.data() + idx.GetRaw() * GetNum();
+  }
+  const T* operator[](const Idx& idx) const {
+#ifdef __RANGE_CHECK
+    assert(idx.GetRaw() >= 0 && idx.GetRaw() < size_);
+#endif
+    return data_.data() + idx.GetRaw() * GetNum();
+  }
+};
+
+template <class T, size_t N = 0>
+using FieldCellMulti = FieldMulti<T, IdxCell, N>;
+
+template <class T, size_t N = 0>
+using FieldFaceMulti = FieldMulti<T, IdxFace, N>;
+
+template <class T, class Idx, size_t N>
+FieldGeneric<T, Idx> GetComponent(const FieldMulti<T, Idx, N>& f_multi,
+                                  size_t n) {
+  FieldGeneric<T, Idx> f_scal(f_multi.GetRange());
+  for (auto idx : f_multi.GetRange()) {
+    f_scal[idx] = f_multi[idx][n];
+  }
+  return f_scal;
+}
+
+template <class T, class Idx, size_t N>
+void SetComponent(FieldMulti<T, Idx, N>& f_multi,
+                  size_t n, const FieldGeneric<T, Idx>& f_scal) {
+  for (auto idx : f_multi.GetRange()) {
+    f_multi[idx][n] = f_scal[idx];
+  }
+}
+
+// Sum of products of components for each index:
+// res[idx] = a[idx][0] * b[idx][0] + a[idx][1] * b[idx][1] + ...
+template <class T, class Idx, size_t N>
+FieldGeneric<T, Idx> Dot(const FieldMulti<T, Idx, N>& a,
+                         const FieldMulti<T, Idx, N>& b) {
+  assert(a.size() == b.size() && a.GetNum() == b.GetNum());
+  FieldGeneric<T, Idx> res(b.GetRange());
+  const size_t num = b.GetNum();
+#pragma omp parallel for schedule(static)
+  for (IntIdx i = 0; i < static_cast<IntIdx>(b.size()); ++i) {
+    const T* pa = a[Idx(i)];
+    const T* pb = b[Idx(i)];
+    T sum(0);
+    for (size_t n = 0; n < num; ++n) {
+      sum += pa[n] * pb[n];
+    }
+    res[Idx(i)] = sum;
+  }
+  return res;
+}
+
+// Same with constant components of a:
+// res[idx] = a[0] * b[idx][0] + a[1] * b[idx][1] + ...
+template <class T, class Idx, size_t N>
+FieldGeneric<T, Idx> Dot(const std::vector<T>& a,
+                         const FieldMulti<T, Idx, N>& b) {
+  assert(a.size() == b.GetNum());
+  FieldGeneric<T, Idx> res(b.GetRange());
+  const size_t num = b.GetNum();
+#pragma omp parallel for schedule(static)
+  for (IntIdx i = 0; i < static_cast<IntIdx>(b.size()); ++i) {
+    const T* pb = b[Idx(i)];
+    T sum(0);
+    for (size_t n = 0; n < num; ++n) {
+      sum += a[n] * pb[n];
+    }
+    res[Idx(i)] = sum;
+  }
+  return res;
+}
+
+// Values at a subset of indices (e.g. boundary conditions).
+// Stored as a vector of (index, value) pairs sorted by index,
+// so traversal is a linear scan over contiguous memory.
+// Insertion in increasing order of indices (the usual case in setup loops)
+// appends, other insertions and erase shift the tail.
+// Insertion and erase invalidate iterators and pointers to values.
 template <class T, class Idx>
 class MapGeneric {
-  using Map = std::map<size_t, T>;
+  using Map = std::vector<std::pair<size_t, T>>;
   Map data_;
 
+  typename Map::iterator Lower(size_t raw) {
+    return std::lower_bound(
+        data_.begin(), data_.end(), raw,
+        [](const typename Map::value_type& a, size_t b) {
+          return a.first < b;
+        });
+  }
+  typename Map::const_iterator Lower(size_t raw) const {
+    return std::lower_bound(
+        data_.cbegin(), data_.cend(), raw,
+        [](const typename Map::value_type& a, size_t b) {
+          return a.first < b;
+        });
+  }
+
  public:
   using IdxType = Idx;
   MapGeneric() {}
   explicit MapGeneric(const FieldGeneric<T, Idx>& field) {
+    data_.reserve(field.size());
     for (size_t i = 0; i < field.size(); ++i) {
-      data_[i] = field[Idx(i)];
+      data_.emplace_back(i, field[Idx(i)]);
     }
   }
   size_t size() const {
     return data_.size();
   }
+  void reserve(size_t size) {
+    data_.reserve(size);
+  }
+  // Inserts default value if not present
   T& operator[](const Idx& idx) {
-    return data_[idx.GetRaw()];
+    const size_t raw = idx.GetRaw();
+    if (data_.empty() || data_.back().first < raw) {
+      data_.emplace_back(raw, T());
+      return data_.back().second;
+    }
+    auto it = Lower(raw);
+    if (it->first != raw) {
+      it = data_.emplace(it, raw, T());
+    }
+    return it->second;
   }
+  // Value must be present
   const T& operator[](const Idx& idx) const {
-    return data_[idx.GetRaw()];
+    auto it = Lower(idx.GetRaw());
+    assert(it != data_.cend() && it->first == idx.GetRaw());
+    return it->second;
   }
   T* find(const Idx& idx) {
-    auto it = data_.find(idx.GetRaw());
-    if (it != data_.end()) {
+    auto it = Lower(idx.GetRaw());
+    if (it != data_.end() && it->first == idx.GetRaw()) {
       return &it->second;
     }
     return nullptr;
   }
   const T * find(const Idx& idx) const {
-    auto it = data_.find(idx.GetRaw());
-    if (it != data_.end()) {
+    auto it = Lower(idx.GetRaw());
+    if (it != data_.cend() && it->first == idx.GetRaw()) {
       return &it->second;
     }
     return nullptr;
   }
   void erase(const Idx& idx) {
-    data_.erase(idx.GetRaw());
+    auto it = Lower(idx.GetRaw());
+    if (it != data_.end() && it->first == idx.GetRaw()) {
+      data_.erase(it);
+    }
   }
 
   class iterator {
@@ -359,6 +1041,161 @@ using MapFace = MapGeneric<T, IdxFace>;
 template <class T>
 using MapNode = MapGeneric<T, IdxNode>;
 
+// Uniform grid of buckets over the bounding box of a set of points,
+// about one point per bucket. Answers nearest-point queries by visiting
+// rings of buckets around the query until no closer point is possible.
+template <class Scal, size_t dim>
+class BucketGrid {
+  using Vect = geom::Vect<Scal, dim>;
+  using MIdx = MIdxGeneral<dim>;
+  std::vector<Vect> points_;
+  Vect lb_;
+  Vect h_; // bucket size
+  MIdx size_; // number of buckets
+  Scal hmin_; // minimal bucket size over non-degenerate axes
+  std::vector<size_t> begin_; // points of bucket b: content_[begin_[b]..]
+  std::vector<size_t> content_;
+
+  size_t GetFlat(MIdx midx) const {
+    size_t res = 0;
+    for (size_t d = dim; d != 0; ) {
+      --d;
+      res *= size_[d];
+      res += midx[d];
+    }
+    return res;
+  }
+  MIdx GetBucket(Vect x) const {
+    MIdx res;
+    for (size_t d = 0; d < dim; ++d) {
+      IntIdx i = static_cast<IntIdx>(std::floor((x[d] - lb_[d]) / h_[d]));
+      res[d] = std::max<IntIdx>(0, std::min<IntIdx>(size_[d] - 1, i));
+    }
+    return res;
+  }
+
+ public:
+  BucketGrid() {}
+  explicit BucketGrid(std::vector<Vect> points)
+      : points_(std::move(points))
+  {
+    if (points_.empty()) {
+      return;
+    }
+    Vect rt = points_[0];
+    lb_ = points_[0];
+    for (auto& x : points_) {
+      for (size_t d = 0; d < dim; ++d) {
+        lb_[d] = std::min(lb_[d], x[d]);
+        rt[d] = std::max(rt[d], x[d]);
+      }
+    }
+    // Bucket size from the volume per point on non-degenerate axes
+    Scal vol = 1.;
+    size_t num_axes = 0;
+    for (size_t d = 0; d < dim; ++d) {
+      if (rt[d] > lb_[d]) {
+        vol *= rt[d] - lb_[d];
+        ++num_axes;
+      }
+    }
+    Scal step = std::pow(vol / points_.size(),
+                         1. / std::max<size_t>(1, num_axes));
+    hmin_ = 0.;
+    for (size_t d = 0; d < dim; ++d) {
+      Scal ext = rt[d] - lb_[d];
+      if (ext > 0.) {
+        size_[d] = std::max<IntIdx>(1, std::min<IntIdx>(
+            points_.size(), static_cast<IntIdx>(std::ceil(ext / step))));
+        h_[d] = ext / size_[d];
+        hmin_ = (hmin_ == 0. ? h_[d] : std::min(hmin_, h_[d]));
+      } else {
+        size_[d] = 1;
+        h_[d] = 1.;
+      }
+    }
+
+    // Fill buckets
+    size_t num_buckets = 1;
+    for (size_t d = 0; d < dim; ++d) {
+      num_buckets *= size_[d];
+    }
+    std::vector<size_t> bucket(points_.size());
+    begin_.assign(num_buckets + 1, 0);
+    for (size_t i = 0; i < points_.size(); ++i) {
+      bucket[i] = GetFlat(GetBucket(points_[i]));
+      ++begin_[bucket[i] + 1];
+    }
+    for (size_t b = 0; b < num_buckets; ++b) {
+      begin_[b + 1] += begin_[b];
+    }
+    content_.resize(points_.size());
+    std::vector<size_t> pos(begin_.begin(), begin_.end() - 1);
+    for (size_t i = 0; i < points_.size(); ++i) {
+      content_[pos[bucket[i]]++] = i;
+    }
+  }
+  size_t size() const {
+    return points_.size();
+  }
+  // Index of the nearest point (the lowest one if several),
+  // size() if there are no points
+  size_t FindNearest(Vect x) const {
+    size_t best = points_.size();
+    Scal best_dist = 0.;
+    const MIdx base = GetBucket(x);
+    IntIdx kmax = 0;
+    for (size_t d = 0; d < dim; ++d) {
+      kmax = std::max<IntIdx>(kmax, size_[d]);
+    }
+    for (IntIdx k = 0; k <= kmax; ++k) {
+      // Buckets at distance k from base
+      MIdx mlb = base - MIdx(k), mrt = base + MIdx(k);
+      for (size_t d = 0; d < dim; ++d) {
+        mlb[d] = std::max<IntIdx>(0, mlb[d]);
+        mrt[d] = std::min<IntIdx>(size_[d] - 1, mrt[d]);
+      }
+      MIdx midx = mlb;
+      while (true) {
+        bool on_ring = false;
+        for (size_t d = 0; d < dim; ++d) {
+          if (std::abs(midx[d] - base[d]) == k) {
+            on_ring = true;
+          }
+        }
+        if (on_ring) {
+          size_t b = GetFlat(midx);
+          for (size_t j = begin_[b]; j < begin_[b + 1]; ++j) {
+            size_t i = content_[j];
+            Scal dist = x.dist(points_[i]);
+            if (best == points_.size() || dist < best_dist ||
+                (dist == best_dist && i < best)) {
+              best = i;
+              best_dist = dist;
+            }
+          }
+        }
+        // Next bucket in [mlb, mrt]
+        size_t d = 0;
+        for (; d < dim; ++d) {
+          if (++midx[d] <= mrt[d]) {
+            break;
+          }
+          midx[d] = mlb[d];
+        }
+        if (d == dim) {
+          break;
+        }
+      }
+      // Points in further rings are at least k * hmin_ away
+      if (best != points_.size() && best_dist < k * hmin_) {
+        break;
+      }
+    }
+    return best;
+  }
+};
+
 // TODO: Neighbour faces iterator introducing (cell, face) pairs
 template <class ScalArg, size_t dim>
 class MeshGeneric {
@@ -409,15 +1246,16 @@ class MeshGeneric {
   virtual bool IsInner(IdxCell) const = 0;
   virtual bool IsInner(IdxFace) const = 0;
   virtual bool IsInside(IdxCell, Vect) const = 0;
-  virtual IdxCell FindNearestCell(Vect point) const {
-    IdxCell idxcell_nearest = IdxCell(0);
-    for (auto idxcell : Cells()) {
-      if (point.dist(GetCenter(idxcell)) <
-          point.dist(GetCenter(idxcell_nearest))) {
-        idxcell_nearest = idxcell;
-      }
+  // Cell with the nearest center
+  virtual IdxCell FindNearestCell(Vect point) const = 0;
+  // Batched FindNearestCell()
+  std::vector<IdxCell> FindNearestCells(const std::vector<Vect>& points) const {
+    std::vector<IdxCell> res(points.size());
+#pragma omp parallel for
+    for (IntIdx i = 0; i < IntIdx(points.size()); ++i) {
+      res[i] = FindNearestCell(points[i]);
     }
-    return idxcell_nearest;
+    return res;
   }
   virtual size_t GetValidNeighbourCellId(IdxFace idxface) const {
     size_t id = 0;
@@ -430,13 +1268,87 @@ class MeshGeneric {
   virtual Vect GetNormal(IdxFace idxface) const {
     return GetSurface(idxface) / GetArea(idxface);
   }
+  // Volumes and areas are taken per radian of revolution about the axis
+  virtual bool IsAxisymmetric() const {
+    return false;
+  }
+  // Metric factor 1/r of hoop terms for axisymmetric meshes
+  // (planar area of cell divided by its volume), zero otherwise
+  virtual Scal GetHoopFactor(IdxCell) const {
+    return 0.;
+  }
 };
 
 
+// Tiled numbering of multi-indices in a block of given size.
+// Tiles are numbered lexicographically, then elements inside each tile
+// are numbered lexicographically (incomplete tiles at the end).
+// midx: offset from the beginning of the block
+template <size_t dim>
+size_t GetTiledFlat(MIdxGeneral<dim> midx,
+                    MIdxGeneral<dim> size, MIdxGeneral<dim> tile) {
+  MIdxGeneral<dim> t, l, w; // tile, offset in tile, tile width
+  for (size_t d = 0; d < dim; ++d) {
+    t[d] = midx[d] / tile[d];
+    l[d] = midx[d] % tile[d];
+    w[d] = std::min(tile[d], size[d] - t[d] * tile[d]);
+  }
+  size_t res = 0;
+  for (size_t d = 0; d < dim; ++d) {
+    size_t s = t[d] * tile[d];
+    for (size_t e = 0; e < d; ++e) {
+      s *= size[e];
+    }
+    for (size_t e = d + 1; e < dim; ++e) {
+      s *= w[e];
+    }
+    res += s;
+  }
+  size_t local = 0;
+  for (size_t d = dim; d != 0; ) {
+    --d;
+    local = local * w[d] + l[d];
+  }
+  return res + local;
+}
+
+// Inverse of GetTiledFlat()
+template <size_t dim>
+MIdxGeneral<dim> GetTiledMIdx(size_t raw,
+                              MIdxGeneral<dim> size, MIdxGeneral<dim> tile) {
+  MIdxGeneral<dim> midx, w;
+  for (size_t d = dim; d != 0; ) {
+    --d;
+    size_t s = tile[d];
+    for (size_t e = 0; e < d; ++e) {
+      s *= size[e];
+    }
+    for (size_t e = d + 1; e < dim; ++e) {
+      s *= w[e];
+    }
+    IntIdx t = raw / s;
+    raw -= t * s;
+    w[d] = std::min(tile[d], size[d] - t * tile[d]);
+    midx[d] = t * tile[d];
+  }
+  for (size_t d = 0; d < dim; ++d) {
+    midx[d] += raw % w[d];
+    raw /= w[d];
+  }
+  return midx;
+}
+
+template <size_t dim>
+bool IsTile(MIdxGeneral<dim> tile) {
+  return MIdxGeneral<dim>::kZero < tile;
+}
+
 template <class IdxType, size_t dim>
 class BlockGeneric {
   using MIdx = geom::MIdxGeneral<dim>;
   MIdx begin_, size_, end_;
+  MIdx tile_; // tiled numbering if positive, lexicographic otherwise
+  bool is_tiled_;
 
  public:
   class iterator {
@@ -483,13 +1395,19 @@ class BlockGeneric {
 
   BlockGeneric()
       : begin_(MIdx::kZero), size_(MIdx::kZero), end_(MIdx::kZero)
+      , tile_(MIdx::kZero), is_tiled_(false)
   {}
   BlockGeneric(MIdx size)
       : begin_(MIdx::kZero), size_(size), end_(begin_ + size_)
+      , tile_(MIdx::kZero), is_tiled_(false)
   {}
-  BlockGeneric(MIdx begin, MIdx size)
+  BlockGeneric(MIdx begin, MIdx size, MIdx tile = MIdx::kZero)
       : begin_(begin), size_(size), end_(begin_ + size_)
+      , tile_(tile), is_tiled_(IsTile(tile))
   {}
+  MIdx GetTile() const {
+    return tile_;
+  }
   MIdx GetDimensions() const {
     return size_;
   }
@@ -551,6 +1469,9 @@ class BlockGeneric {
   }*/
   IdxType GetIdx(MIdx midx) const {
     midx -= begin_;
+    if (is_tiled_) {
+      return IdxType(GetTiledFlat(midx, size_, tile_));
+    }
     size_t res = 0;
     for (size_t i = dim; i != 0; ) {
       --i;
@@ -559,7 +1480,26 @@ class BlockGeneric {
     }
     return IdxType(res);
   }
+  // Lines of indices along direction d ordered lexicographically
+  // by the remaining components. Requires lexicographic numbering.
+  std::vector<StridedRange<IdxType>> GetLines(size_t d) const {
+    assert(!is_tiled_);
+    size_t stride = 1;
+    for (size_t i = 0; i < d; ++i) {
+      stride *= size_[i];
+    }
+    MIdx plane = size_;
+    plane[d] = 1;
+    std::vector<StridedRange<IdxType>> res;
+    for (auto midx : BlockGeneric(begin_, plane)) {
+      res.emplace_back(GetIdx(midx).GetRaw(), stride, size_[d]);
+    }
+    return res;
+  }
   MIdx GetMIdx(IdxType idx) const {
+    if (is_tiled_) {
+      return GetTiledMIdx(idx.GetRaw(), size_, tile_);
+    }
     MIdx midx;
     size_t raw = idx.GetRaw();
     for (size_t i = 0; i < dim; ++i) {
@@ -596,6 +1536,93 @@ using BlockCells = BlockGeneric<IdxCell, dim>;
 template <size_t dim>
 using BlockNodes = BlockGeneric<IdxNode, dim>;
 
+// Non-owning view of a cell field over the sub-box [begin, begin + size)
+// of its block. Element i of the view is the cell with index i
+// in BlockCells(size), so the view is indexed like a field
+// on a mesh of the sub-box. Indices are mapped with strides,
+// both numberings must be lexicographic.
+// Assignment writes elements to the viewed field (like std::slice_array).
+// T is const for a view of a const field.
+template <class T, size_t dim>
+class FieldCellView : public FieldExpr<FieldCellView<T, dim>, IdxCell> {
+  using MIdx = MIdxGeneral<dim>;
+  T* data_;
+  MIdx size_;
+  MIdx stride_;   // strides of the viewed field
+  size_t offset_; // index of begin in the viewed field
+
+ public:
+  using ExprRef = FieldCellView;
+  using ValueType = typename std::remove_const<T>::type;
+  FieldCellView()
+      : data_(nullptr), size_(MIdx::kZero), stride_(MIdx::kZero), offset_(0)
+  {}
+  template <class F>
+  FieldCellView(F& field, const BlockCells<dim>& block,
+                MIdx begin, MIdx size)
+      : data_(field.data()), size_(size), offset_(0)
+  {
+    assert(!IsTile(block.GetTile()));
+    assert(field.size() == block.size());
+    assert(block.IsInside(begin) && block.IsInside(begin + size - MIdx(1)));
+    const MIdx rel = begin - block.GetBegin();
+    size_t stride = 1;
+    for (size_t d = 0; d < dim; ++d) {
+      stride_[d] = stride;
+      offset_ += rel[d] * stride;
+      stride *= block.GetDimensions()[d];
+    }
+  }
+  FieldCellView(const FieldCellView&) = default;
+  MIdx GetDimensions() const {
+    return size_;
+  }
+  size_t size() const {
+    size_t res = 1;
+    for (size_t d = 0; d < dim; ++d) {
+      res *= size_[d];
+    }
+    return res;
+  }
+  // Index in the viewed field of element i
+  size_t GetRaw(size_t i) const {
+    size_t raw = offset_;
+    for (size_t d = 0; d < dim; ++d) {
+      raw += (i % size_[d]) * stride_[d];
+      i /= size_[d];
+    }
+    return raw;
+  }
+  T& operator[](IdxCell idx) const {
+    return data_[GetRaw(idx.GetRaw())];
+  }
+  const T& Eval(size_t i) const {
+    return data_[GetRaw(i)];
+  }
+  // Evaluates expression indexed like the view into the viewed field,
+  // one contiguous line along direction 0 at a time.
+  // Expression must not read the viewed field elsewhere.
+  template <class E>
+  FieldCellView& operator=(const FieldExpr<E, IdxCell>& expr) {
+    const E& e = expr.Self();
+    assert(e.size() == size());
+    const IntIdx nx = size_[0];
+    const IntIdx nlines = (nx > 0 ? size() / nx : 0);
+#pragma omp parallel for
+    for (IntIdx l = 0; l < nlines; ++l) {
+      T* line = data_ + GetRaw(l * nx);
+      for (IntIdx i = 0; i < nx; ++i) {
+        line[i] = e.Eval(l * nx + i);
+      }
+    }
+    return *this;
+  }
+  FieldCellView& operator=(const FieldCellView& other) {
+    return *this = static_cast<const FieldExpr<FieldCellView, IdxCell>&>(
+        other);
+  }
+};
+
 
 template <size_t dim>
 class Direction {
@@ -642,6 +1669,8 @@ class BlockFaces {
   using MIdx = MIdxGeneral<dim>;
   using Direction = geom::Direction<dim>;
   MIdx block_cells_size_;
+  MIdx tile_; // tiled numbering within each direction if positive
+  bool is_tiled_;
   size_t GetNumFaces(Direction dir) const {
     MIdx bcs = block_cells_size_;
     ++bcs[dir];
@@ -657,6 +1686,9 @@ class BlockFaces {
   size_t GetFlat(MIdx midx, Direction dir) const {
     MIdx bcs = block_cells_size_;
     ++bcs[dir];
+    if (is_tiled_) {
+      return GetTiledFlat(midx, bcs, tile_);
+    }
     size_t res = 0;
     for (size_t i = dim; i != 0; ) {
       --i;
@@ -668,6 +1700,9 @@ class BlockFaces {
   MIdx GetMIdxFromOffset(size_t raw, Direction dir) const {
     MIdx bcs = block_cells_size_;
     ++bcs[dir];
+    if (is_tiled_) {
+      return GetTiledMIdx(raw, bcs, tile_);
+    }
     MIdx midx;
     for (size_t i = 0; i < dim; ++i) {
       midx[i] = raw % bcs[i];
@@ -689,9 +1724,11 @@ class BlockFaces {
  public:
   BlockFaces()
       : block_cells_size_(MIdx::kZero)
+      , tile_(MIdx::kZero), is_tiled_(false)
   {}
-  BlockFaces(MIdx block_cells_size)
+  BlockFaces(MIdx block_cells_size, MIdx tile = MIdx::kZero)
       : block_cells_size_(block_cells_size)
+      , tile_(tile), is_tiled_(IsTile(tile))
   {}
   size_t size() const {
     size_t res = 0;
@@ -714,6 +1751,24 @@ class BlockFaces {
   MIdx GetMIdx(IdxFace idx) const {
     return GetMIdxDirection(idx).first;
   }
+  // Lines of faces of direction dir along dir, matching the lines
+  // of BlockCells::GetLines(dir). Requires lexicographic numbering.
+  std::vector<StridedRange<IdxFace>> GetLines(Direction dir) const {
+    assert(!is_tiled_);
+    MIdx bcs = block_cells_size_;
+    ++bcs[dir];
+    size_t stride = 1;
+    for (size_t i = 0; i < dir; ++i) {
+      stride *= bcs[i];
+    }
+    MIdx plane = bcs;
+    plane[dir] = 1;
+    std::vector<StridedRange<IdxFace>> res;
+    for (auto midx : BlockCells<dim>(plane)) {
+      res.emplace_back(GetIdx(midx, dir).GetRaw(), stride, bcs[dir]);
+    }
+    return res;
+  }
   Direction GetDirection(IdxFace idx) const {
     return GetMIdxDirection(idx).second;
   }
@@ -727,12 +1782,32 @@ void InitUniformMesh(Mesh& mesh,
   using MIdx = typename Mesh::MIdx;
   typename Mesh::BlockNodes b_nodes(mesh_size + MIdx(1));
   FieldNode<Vect> fn_node(b_nodes);
-  for (auto midx : b_nodes) {
-    IdxNode idxnode = b_nodes.GetIdx(midx);
-    Vect unit = Vect(midx) / Vect(mesh_size);
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_nodes.size()); ++raw) {
+    IdxNode idxnode(raw);
+    Vect unit = Vect(b_nodes.GetMIdx(idxnode)) / Vect(mesh_size);
     fn_node[idxnode] = domain.lb + unit * domain.GetDimensions();
   }
-  mesh = Mesh(b_nodes, fn_node);
+  mesh = Mesh(b_nodes, std::move(fn_node));
+}
+
+// Same with tiled numbering of cells and faces
+template <class Mesh>
+void InitUniformMesh(Mesh& mesh,
+                     const Rect<typename Mesh::Vect>& domain,
+                     typename Mesh::MIdx mesh_size,
+                     typename Mesh::MIdx tile) {
+  using Vect = typename Mesh::Vect;
+  using MIdx = typename Mesh::MIdx;
+  typename Mesh::BlockNodes b_nodes(mesh_size + MIdx(1));
+  FieldNode<Vect> fn_node(b_nodes);
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_nodes.size()); ++raw) {
+    IdxNode idxnode(raw);
+    Vect unit = Vect(b_nodes.GetMIdx(idxnode)) / Vect(mesh_size);
+    fn_node[idxnode] = domain.lb + unit * domain.GetDimensions();
+  }
+  mesh = Mesh(b_nodes, std::move(fn_node), tile);
 }
 
 
@@ -930,5 +2005,105 @@ class SearchMesh {
 
 };
 
+// Point location on axis-aligned structured meshes (nodes are a tensor
+// product of per-axis coordinates). The cell follows from the coordinates
+// directly for uniform axes and by binary search otherwise,
+// so there is no setup beyond copying the coordinates.
+template <class Mesh>
+class LocatorStructured {
+  const Mesh& mesh;
+  using Scal = typename Mesh::Scal;
+  using Vect = typename Mesh::Vect;
+  static constexpr size_t dim = Mesh::dim;
+  using MIdx = geom::MIdxGeneral<dim>;
+  std::array<std::vector<Scal>, dim> nodes_; // node coordinates along axes
+  std::array<bool, dim> is_uniform_;
+  Vect h_; // mesh step on uniform axes
+
+  // Index of interval of axis d containing x, clipped to valid range
+  IntIdx Locate(size_t d, Scal x) const {
+    const auto& v = nodes_[d];
+    IntIdx n = static_cast<IntIdx>(v.size()) - 1;
+    IntIdx i;
+    if (is_uniform_[d]) {
+      i = static_cast<IntIdx>(std::floor((x - v[0]) / h_[d]));
+    } else {
+      i = std::upper_bound(v.begin(), v.end(), x) - v.begin() - 1;
+    }
+    return std::max<IntIdx>(0, std::min<IntIdx>(n - 1, i));
+  }
+  bool IsInside(size_t d, Scal x) const {
+    return nodes_[d].front() <= x && x <= nodes_[d].back();
+  }
+
+ public:
+  explicit LocatorStructured(const Mesh& mesh)
+      : mesh(mesh)
+  {
+    const auto& bn = mesh.GetBlockNodes();
+    const MIdx mb = bn.GetBegin();
+    const MIdx size = bn.GetDimensions();
+    for (size_t d = 0; d < dim; ++d) {
+      MIdx midx = mb;
+      for (IntIdx i = 0; i < size[d]; ++i) {
+        midx[d] = mb[d] + i;
+        nodes_[d].push_back(mesh.GetNode(bn.GetIdx(midx))[d]);
+      }
+      Scal len = nodes_[d].back() - nodes_[d].front();
+      h_[d] = len / (size[d] - 1);
+      is_uniform_[d] = true;
+      for (IntIdx i = 0; i < size[d]; ++i) {
+        if (std::abs(nodes_[d][i] - (nodes_[d][0] + h_[d] * i)) >
+            1e-12 * std::abs(len)) {
+          is_uniform_[d] = false;
+        }
+      }
+    }
+    const Scal tol = 1e-12 * (nodes_[0].back() - nodes_[0].front());
+    for (auto midx : bn) {
+      Vect node = mesh.GetNode(bn.GetIdx(midx));
+      for (size_t d = 0; d < dim; ++d) {
+        if (std::abs(node[d] - nodes_[d][midx[d] - mb[d]]) > tol) {
+          throw std::runtime_error("LocatorStructured: mesh not axis-aligned");
+        }
+      }
+    }
+  }
+  // Cell containing the point, None if outside the mesh
+  IdxCell FindCell(Vect vect) const {
+    const auto& bc = mesh.GetBlockCells();
+    MIdx midx;
+    for (size_t d = 0; d < dim; ++d) {
+      if (!IsInside(d, vect[d])) {
+        return IdxCell::None();
+      }
+      midx[d] = bc.GetBegin()[d] + Locate(d, vect[d]);
+    }
+    return bc.GetIdx(midx);
+  }
+  // Calls f(idxcell) for cells with centers at distance within radius
+  template <class F>
+  void ForNearbyCells(Vect center, Scal radius, F f) const {
+    const auto& bc = mesh.GetBlockCells();
+    MIdx mlb, mrt;
+    for (size_t d = 0; d < dim; ++d) {
+      mlb[d] = bc.GetBegin()[d] + Locate(d, center[d] - radius);
+      mrt[d] = bc.GetBegin()[d] + Locate(d, center[d] + radius);
+    }
+    for (auto midx : geom::BlockGeneric<size_t, dim>(
+        mlb, mrt - mlb + MIdx(1))) {
+      IdxCell idxcell = bc.GetIdx(midx);
+      if (center.dist(mesh.GetCenter(idxcell)) <= radius) {
+        f(idxcell);
+      }
+    }
+  }
+  std::vector<IdxCell> GetNearbyCells(Vect center, Scal radius) const {
+    std::vector<IdxCell> res;
+    ForNearbyCells(center, radius, [&res](IdxCell c) { res.push_back(c); });
+    return res;
+  }
+};
+
 
 } // namespace geom
@@ -14,8 +14,10 @@ namespace geom {
 namespace geom1d {
 
 
+// Final, so that kernels templated on Mesh call accessors without
+// virtual dispatch. MeshGeneric remains the interface for generic code.
 template <class Scal>
-class MeshStructured : public MeshGeneric<Scal, 1> {
+class MeshStructured final : public MeshGeneric<Scal, 1> {
  public:
   static constexpr size_t dim = 1;
   using Vect = geom::Vect<Scal, dim>;
@@ -37,10 +39,13 @@ class MeshStructured : public MeshGeneric<Scal, 1> {
   BlockFaces b_faces_;
   FieldCell<Vect> fc_center_;
   FieldCell<Scal> fc_volume_;
+  // Bucket grid of cell centers, shared by copies of the mesh
+  std::shared_ptr<const BucketGrid<Scal, 1>> center_grid_;
   FieldFace<Vect> ff_center_;
   FieldFace<Scal> ff_area_;
   FieldFace<Vect> ff_surface_;
   std::array<IntIdx, kCellNumNeighbourFaces> cell_neighbour_cell_offset_;
+  FieldCell<std::array<IdxCell, kCellNumNeighbourFaces>> fc_neighbour_cell_;
   FieldCell<std::array<IdxFace, kCellNumNeighbourFaces>> fc_neighbour_face_;
   FieldCell<IdxNode> fc_neighbour_node_base_;
   std::array<IntIdx, kCellNumNeighbourNodes> cell_neighbour_node_offset_;
@@ -51,6 +56,11 @@ class MeshStructured : public MeshGeneric<Scal, 1> {
   FieldFace<bool> ff_is_inner_;
   FieldCell<bool> fc_is_excluded_;
   FieldFace<bool> ff_is_excluded_;
+  RangeList<IdxCell> inner_cells_;
+  RangeList<IdxCell> boundary_cells_;
+  RangeList<IdxCell> active_cells_;
+  RangeList<IdxFace> inner_faces_;
+  RangeList<IdxFace> boundary_faces_;
 
  public:
   MeshStructured() {}
@@ -67,6 +77,10 @@ class MeshStructured : public MeshGeneric<Scal, 1> {
   Vect GetCenter(IdxCell idx) const override {
     return fc_center_[idx];
   }
+  // Cell with the nearest center
+  IdxCell FindNearestCell(Vect point) const override {
+    return IdxCell(center_grid_->FindNearest(point));
+  }
   Vect GetCenter(IdxFace idx) const override {
     return ff_center_[idx];
   }
@@ -91,20 +105,22 @@ class MeshStructured : public MeshGeneric<Scal, 1> {
   size_t GetNumNodes() const override {
     return b_nodes_.size();
   }
+  // Shadow MeshGeneric::Cells() etc. which call GetNum*() virtually
+  Range<IdxCell> Cells() const {
+    return Range<IdxCell>(0, b_cells_.size());
+  }
+  Range<IdxFace> Faces() const {
+    return Range<IdxFace>(0, b_faces_.size());
+  }
+  Range<IdxNode> Nodes() const {
+    return Range<IdxNode>(0, b_nodes_.size());
+  }
+  Vect GetNormal(IdxFace idxface) const override {
+    return ff_surface_[idxface] / ff_area_[idxface];
+  }
   // n = 0 .. 1
   IdxCell GetNeighbourCell(IdxCell idx, size_t n) const override {
-    if (fc_is_inner_[idx]) {
-      idx.AddRaw(cell_neighbour_cell_offset_[n]);
-    } else {
-      MIdx base = b_cells_.GetMIdx(idx);
-      MIdx offset = (std::vector<MIdx>{MIdx{-1}, MIdx{1}})[n];
-      if (b_cells_.IsInside(base + offset)) {
-        idx.AddRaw(cell_neighbour_cell_offset_[n]);
-      } else {
-        idx = IdxCell::None();
-      }
-    }
-    return idx;
+    return fc_neighbour_cell_[idx][n];
   }
   // n same as for GetNeighbourCell()
   IdxFace GetNeighbourFace(IdxCell idxcell, size_t n) const override {
@@ -186,6 +202,27 @@ class MeshStructured : public MeshGeneric<Scal, 1> {
         ff_is_excluded_[idxface] = true;
       }
     }
+    UpdateRanges();
+  }
+  // Cells with IsInner()
+  const RangeList<IdxCell>& InnerCells() const {
+    return inner_cells_;
+  }
+  // Cells neither inner nor excluded
+  const RangeList<IdxCell>& BoundaryCells() const {
+    return boundary_cells_;
+  }
+  // Cells not excluded
+  const RangeList<IdxCell>& ActiveCells() const {
+    return active_cells_;
+  }
+  // Faces with two neighbour cells
+  const RangeList<IdxFace>& InnerFaces() const {
+    return inner_faces_;
+  }
+  // Faces with one neighbour cell
+  const RangeList<IdxFace>& BoundaryFaces() const {
+    return boundary_faces_;
   }
   bool IsExcluded(IdxCell idxcell) const {
     return fc_is_excluded_[idxcell];
@@ -195,6 +232,35 @@ class MeshStructured : public MeshGeneric<Scal, 1> {
   }
 
  private:
+  // Runs of inner and boundary cells and faces
+  void UpdateRanges() {
+    inner_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return fc_is_inner_[c]; });
+    boundary_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return !fc_is_inner_[c] && !fc_is_excluded_[c]; });
+    active_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return !fc_is_excluded_[c]; });
+    inner_faces_ = RangeList<IdxFace>(b_faces_.size(), [this](IdxFace f) {
+        return ff_is_inner_[f]; });
+    boundary_faces_ = RangeList<IdxFace>(b_faces_.size(), [this](IdxFace f) {
+        return !ff_is_inner_[f] && !ff_is_excluded_[f]; });
+  }
+  // Neighbour cell through face n, None if outside the block
+  IdxCell CalcNeighbourCell(IdxCell idx, size_t n) const {
+    if (fc_is_inner_[idx]) {
+      idx.AddRaw(cell_neighbour_cell_offset_[n]);
+    } else {
+      MIdx offset(0);
+      offset[n / 2] = (n % 2 == 0 ? -1 : 1);
+      if (b_cells_.IsInside(b_cells_.GetMIdx(idx) + offset)) {
+        idx.AddRaw(cell_neighbour_cell_offset_[n]);
+      } else {
+        idx = IdxCell::None();
+      }
+    }
+    return idx;
+  }
+
    Vect CalcCenter(IdxCell idxcell) const {
      Vect res = Vect::kZero;
      for (size_t i = 0; i < GetNumNeighbourNodes(idxcell); ++i) {
@@ -237,6 +303,7 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
     , ff_center_(b_faces_)
     , ff_area_(b_faces_)
     , ff_surface_(b_faces_)
+    , fc_neighbour_cell_(b_cells_)
     , fc_neighbour_face_(b_cells_)
     , fc_neighbour_node_base_(b_cells_)
     , ff_direction_(b_faces_)
@@ -274,6 +341,13 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
     cell_neighbour_cell_offset_ = {{offset(-1), offset(1)}};
   }
 
+  // Neighbour cells of cells
+  for (auto idxcell : this->Cells()) {
+    for (size_t n = 0; n < kCellNumNeighbourFaces; ++n) {
+      fc_neighbour_cell_[idxcell][n] = CalcNeighbourCell(idxcell, n);
+    }
+  }
+
   // Offset for cell neighbour nodes
   {
     auto offset = [this](IntIdx i) {
@@ -316,11 +390,16 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
     fc_center_[idx] = CalcCenter(idx);
     fc_volume_[idx] = CalcVolume(idx);
   }
+  center_grid_ = std::make_shared<const BucketGrid<Scal, 1>>(
+      std::vector<Vect>(fc_center_.data(),
+                        fc_center_.data() + fc_center_.size()));
 
   for (auto idxface : this->Faces()) {
     ff_is_inner_[idxface] = (!GetNeighbourCell(idxface, 0).IsNone() &&
         !GetNeighbourCell(idxface, 1).IsNone());
   }
+
+  UpdateRanges();
 }
 
 } // namespace geom1d
@@ -17,8 +17,10 @@ namespace geom {
 namespace geom2d {
 
 
+// Final, so that kernels templated on Mesh call accessors without
+// virtual dispatch. MeshGeneric remains the interface for generic code.
 template <class Scal>
-class MeshStructured : public MeshGeneric<Scal, 2> {
+class MeshStructured final : public MeshGeneric<Scal, 2> {
  public:
   static constexpr size_t dim = 2;
   using Vect = geom::Vect<Scal, dim>;
@@ -40,10 +42,13 @@ class MeshStructured : public MeshGeneric<Scal, 2> {
   BlockFaces b_faces_;
   FieldCell<Vect> fc_center_;
   FieldCell<Scal> fc_volume_;
+  // Bucket grid of cell centers, shared by copies of the mesh
+  std::shared_ptr<const BucketGrid<Scal, 2>> center_grid_;
   FieldFace<Vect> ff_center_;
   FieldFace<Scal> ff_area_;
   FieldFace<Vect> ff_surface_;
   std::array<IntIdx, kCellNumNeighbourFaces> cell_neighbour_cell_offset_;
+  FieldCell<std::array<IdxCell, kCellNumNeighbourFaces>> fc_neighbour_cell_;
   FieldCell<std::array<IdxFace, kCellNumNeighbourFaces>> fc_neighbour_face_;
   FieldCell<IdxNode> fc_neighbour_node_base_;
   std::array<IntIdx, kCellNumNeighbourNodes> cell_neighbour_node_offset_;
@@ -55,10 +60,20 @@ class MeshStructured : public MeshGeneric<Scal, 2> {
   FieldFace<bool> ff_is_inner_;
   FieldCell<bool> fc_is_excluded_;
   FieldFace<bool> ff_is_excluded_;
+  FieldCell<Scal> fc_hoop_; // empty unless axisymmetric
+  FieldFace<Vect> ff_normal_; // planar normals, empty unless axisymmetric
+  RangeList<IdxCell> inner_cells_;
+  RangeList<IdxCell> boundary_cells_;
+  RangeList<IdxCell> active_cells_;
+  RangeList<IdxFace> inner_faces_;
+  RangeList<IdxFace> boundary_faces_;
 
  public:
   MeshStructured() {}
-  MeshStructured(const BlockNodes& b_nodes, const FieldNode<Vect>& fn_node);
+  // tile: size of tiles for numbering of cells and faces
+  // (lexicographic if zero)
+  MeshStructured(const BlockNodes& b_nodes, FieldNode<Vect> fn_node,
+                 MIdx tile = MIdx(0));
   const BlockCells& GetBlockCells() const {
     return b_cells_;
   }
@@ -71,6 +86,10 @@ class MeshStructured : public MeshGeneric<Scal, 2> {
   Vect GetCenter(IdxCell idx) const override {
     return fc_center_[idx];
   }
+  // Cell with the nearest center
+  IdxCell FindNearestCell(Vect point) const override {
+    return IdxCell(center_grid_->FindNearest(point));
+  }
   Vect GetCenter(IdxFace idx) const override {
     return ff_center_[idx];
   }
@@ -95,21 +114,25 @@ class MeshStructured : public MeshGeneric<Scal, 2> {
   size_t GetNumNodes() const override {
     return b_nodes_.size();
   }
+  // Shadow MeshGeneric::Cells() etc. which call GetNum*() virtually
+  Range<IdxCell> Cells() const {
+    return Range<IdxCell>(0, b_cells_.size());
+  }
+  Range<IdxFace> Faces() const {
+    return Range<IdxFace>(0, b_faces_.size());
+  }
+  Range<IdxNode> Nodes() const {
+    return Range<IdxNode>(0, b_nodes_.size());
+  }
+  Vect GetNormal(IdxFace idxface) const override {
+    if (!ff_normal_.empty()) { // axisymmetric
+      return ff_normal_[idxface];
+    }
+    return ff_surface_[idxface] / ff_area_[idxface];
+  }
   // n = 0 .. 3
   IdxCell GetNeighbourCell(IdxCell idx, size_t n) const override {
-    if (fc_is_inner_[idx]) {
-      idx.AddRaw(cell_neighbour_cell_offset_[n]);
-    } else {
-      MIdx base = b_cells_.GetMIdx(idx);
-      MIdx offset = (std::vector<MIdx>{
-        MIdx{-1, 0}, MIdx{1, 0}, MIdx{0, -1}, MIdx{0, 1}})[n];
-      if (b_cells_.IsInside(base + offset)) {
-        idx.AddRaw(cell_neighbour_cell_offset_[n]);
-      } else {
-        idx = IdxCell::None();
-      }
-    }
-    return idx;
+    return fc_neighbour_cell_[idx][n];
   }
   // n same as for GetNeighbourCell()
   IdxFace GetNeighbourFace(IdxCell idxcell, size_t n) const override {
@@ -203,6 +226,37 @@ class MeshStructured : public MeshGeneric<Scal, 2> {
         ff_is_excluded_[idxface] = true;
       }
     }
+    UpdateRanges();
+  }
+  // Cells with IsInner()
+  const RangeList<IdxCell>& InnerCells() const {
+    return inner_cells_;
+  }
+  // Cells neither inner nor excluded
+  const RangeList<IdxCell>& BoundaryCells() const {
+    return boundary_cells_;
+  }
+  // Cells not excluded
+  const RangeList<IdxCell>& ActiveCells() const {
+    return active_cells_;
+  }
+  // Faces with two neighbour cells
+  const RangeList<IdxFace>& InnerFaces() const {
+    return inner_faces_;
+  }
+  // Faces with one neighbour cell
+  const RangeList<IdxFace>& BoundaryFaces() const {
+    return boundary_faces_;
+  }
+  // Axisymmetric geometry: x is the radial coordinate (x >= 0),
+  // volumes and areas are taken per radian of revolution about x = 0.
+  // Faces on the axis have zero area.
+  void MakeAxisymmetric();
+  bool IsAxisymmetric() const override {
+    return !fc_hoop_.empty();
+  }
+  Scal GetHoopFactor(IdxCell idxcell) const override {
+    return fc_hoop_.empty() ? 0. : fc_hoop_[idxcell];
   }
   bool IsExcluded(IdxCell idxcell) const {
     return fc_is_excluded_[idxcell];
@@ -212,6 +266,41 @@ class MeshStructured : public MeshGeneric<Scal, 2> {
   }
 
  private:
+  // Runs of inner and boundary cells and faces
+  void UpdateRanges() {
+    inner_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return fc_is_inner_[c]; });
+    boundary_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return !fc_is_inner_[c] && !fc_is_excluded_[c]; });
+    active_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return !fc_is_excluded_[c]; });
+    inner_faces_ = RangeList<IdxFace>(b_faces_.size(), [this](IdxFace f) {
+        return ff_is_inner_[f]; });
+    boundary_faces_ = RangeList<IdxFace>(b_faces_.size(), [this](IdxFace f) {
+        return !ff_is_inner_[f] && !ff_is_excluded_[f]; });
+  }
+  // Neighbour cell through face n, None if outside the block
+  IdxCell CalcNeighbourCell(IdxCell idx, size_t n) const {
+    MIdx offset(0);
+    offset[n / 2] = (n % 2 == 0 ? -1 : 1);
+    if (IsTile(b_cells_.GetTile())) {
+      // Offsets are not constant with tiled numbering
+      MIdx midx = b_cells_.GetMIdx(idx) + offset;
+      return b_cells_.IsInside(midx) ?
+          b_cells_.GetIdx(midx) : IdxCell::None();
+    }
+    if (fc_is_inner_[idx]) {
+      idx.AddRaw(cell_neighbour_cell_offset_[n]);
+    } else {
+      if (b_cells_.IsInside(b_cells_.GetMIdx(idx) + offset)) {
+        idx.AddRaw(cell_neighbour_cell_offset_[n]);
+      } else {
+        idx = IdxCell::None();
+      }
+    }
+    return idx;
+  }
+
    Vect CalcCenter(IdxCell idxcell) const {
      Vect res = Vect::kZero;
      for (size_t i = 0; i < GetNumNeighbourNodes(idxcell); ++i) {
@@ -247,16 +336,18 @@ class MeshStructured : public MeshGeneric<Scal, 2> {
 
 template <class Scal>
 MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
-                                          const FieldNode<Vect>& fn_node)
+                                          FieldNode<Vect> fn_node,
+                                          MIdx tile)
     : b_nodes_(b_nodes)
-    , fn_node_(fn_node)
-    , b_cells_(b_nodes_.GetBegin(), b_nodes_.GetDimensions() - MIdx(1))
-    , b_faces_(b_cells_.GetDimensions())
+    , fn_node_(std::move(fn_node))
+    , b_cells_(b_nodes_.GetBegin(), b_nodes_.GetDimensions() - MIdx(1), tile)
+    , b_faces_(b_cells_.GetDimensions(), tile)
     , fc_center_(b_cells_)
     , fc_volume_(b_cells_)
     , ff_center_(b_faces_)
     , ff_area_(b_faces_)
     , ff_surface_(b_faces_)
+    , fc_neighbour_cell_(b_cells_)
     , fc_neighbour_face_(b_cells_)
     , fc_neighbour_node_base_(b_cells_)
     , ff_direction_(b_faces_)
@@ -270,9 +361,13 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
 {
   MIdx mb = b_cells_.GetBegin(), me = b_cells_.GetEnd();
 
+  // Loops below are independent over elements and run in parallel
+
   // Base for cell neighbours
-  for (auto midx : b_cells_) {
-    IdxCell idxcell(b_cells_.GetIdx(midx));
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idxcell(raw);
+    MIdx midx = mb + b_cells_.GetMIdx(idxcell);
     fc_neighbour_node_base_[idxcell] = b_nodes_.GetIdx(midx);
 
     auto nface = [this, midx](IntIdx i, IntIdx j, Direction dir) {
@@ -283,7 +378,13 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
         nface(1, 0, Direction::i),
         nface(0, 0, Direction::j),
         nface(0, 1, Direction::j)}};
+  }
 
+  // Mark inner cells.
+  // Serial: bool fields pack bits, parallel writes would race
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idxcell(raw);
+    MIdx midx = mb + b_cells_.GetMIdx(idxcell);
     fc_is_inner_[idxcell] = (mb < midx && midx + MIdx(1) < me);
     #ifdef PERX
     // adhoc for periodic in x
@@ -310,6 +411,15 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
                                   offset(0, -1), offset(0, 1)}};
   }
 
+  // Neighbour cells of cells
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idxcell(raw);
+    for (size_t n = 0; n < kCellNumNeighbourFaces; ++n) {
+      fc_neighbour_cell_[idxcell][n] = CalcNeighbourCell(idxcell, n);
+    }
+  }
+
   // Offset for cell neighbour nodes
   {
     auto offset = [this](IntIdx i, IntIdx j) {
@@ -323,7 +433,10 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
 
   // Base for i-face and j-face neighbours
   for (Direction dir : {Direction::i, Direction::j}) {
-    for (auto midx : BlockCells(mb, me - mb + dir)) {
+    BlockCells bf(me - mb + dir);
+#pragma omp parallel for
+    for (IntIdx raw = 0; raw < IntIdx(bf.size()); ++raw) {
+      MIdx midx = mb + bf.GetMIdx(IdxCell(raw));
       IdxFace idxface = b_faces_.GetIdx(midx, dir);
       ff_direction_[idxface] = dir;
       ff_neighbour_cell_[idxface] = {{
@@ -371,21 +484,31 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
   }
 
   // Face centers, area
-  for (auto idx : this->Faces()) {
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_faces_.size()); ++raw) {
+    IdxFace idx(raw);
     ff_center_[idx] = CalcCenter(idx);
     ff_area_[idx] = CalcArea(idx);
     ff_surface_[idx] = CalcSurface(idx);
   }
 
   // Cell centers, volume
-  for (auto idx : this->Cells()) {
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idx(raw);
     fc_center_[idx] = CalcCenter(idx);
     fc_volume_[idx] = CalcVolume(idx);
   }
+  center_grid_ = std::make_shared<const BucketGrid<Scal, 2>>(
+      std::vector<Vect>(fc_center_.data(),
+                        fc_center_.data() + fc_center_.size()));
 
   // Vect to cell
   for (Direction dir : {Direction::i, Direction::j}) {
-    for (auto midx : BlockCells(mb, me - mb + dir)) {
+    BlockCells bf(me - mb + dir);
+#pragma omp parallel for
+    for (IntIdx raw = 0; raw < IntIdx(bf.size()); ++raw) {
+      MIdx midx = mb + bf.GetMIdx(IdxCell(raw));
       IdxFace idxface = b_faces_.GetIdx(midx, dir);
       IdxCell c;
       c = GetNeighbourCell(idxface, 0);
@@ -425,12 +548,61 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
     }
   }
 
-  // Mark inner faces
-  for (auto idxface : this->Faces()) {
+  // Mark inner faces (serial, as for cells)
+  for (IntIdx raw = 0; raw < IntIdx(b_faces_.size()); ++raw) {
+    IdxFace idxface(raw);
     ff_is_inner_[idxface] = (!GetNeighbourCell(idxface, 0).IsNone() &&
         !GetNeighbourCell(idxface, 1).IsNone());
   }
 
+  UpdateRanges();
+
+}
+
+template <class Scal>
+void MeshStructured<Scal>::MakeAxisymmetric() {
+  if (IsAxisymmetric()) {
+    return;
+  }
+  for (auto idxnode : Nodes()) {
+    if (GetNode(idxnode)[0] < 0.) {
+      throw std::runtime_error(
+          "MeshStructured::MakeAxisymmetric: node with x < 0");
+    }
+  }
+
+  // Cell volumes, exact for straight edges:
+  // integral of x over the cell is sum over edges of
+  // n_x * length * (xa^2 + xa * xb + xb^2) / 6
+  FieldCell<Scal> fc_volume(b_cells_);
+  fc_hoop_.Reinit(b_cells_);
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idxcell(raw);
+    Scal res = 0.;
+    for (size_t i = 0; i < GetNumNeighbourFaces(idxcell); ++i) {
+      IdxFace idxface = GetNeighbourFace(idxcell, i);
+      Scal xa = GetNode(GetNeighbourNode(idxface, 0))[0];
+      Scal xb = GetNode(GetNeighbourNode(idxface, 1))[0];
+      res += GetOutwardSurface(idxcell, i)[0] *
+          (xa * xa + xa * xb + xb * xb) / 6.;
+    }
+    fc_volume[idxcell] = res;
+    fc_hoop_[idxcell] = fc_volume_[idxcell] / res;
+  }
+  fc_volume_ = fc_volume;
+
+  // Face areas, weighted by the mean radius of the edge.
+  // Normals are kept from planar areas (faces on the axis have zero area)
+  ff_normal_.Reinit(b_faces_);
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_faces_.size()); ++raw) {
+    IdxFace idxface(raw);
+    ff_normal_[idxface] = ff_surface_[idxface] / ff_area_[idxface];
+    Scal r = ff_center_[idxface][0];
+    ff_area_[idxface] *= r;
+    ff_surface_[idxface] *= r;
+  }
 }
 
 } // namespace geom2d
@@ -17,8 +17,10 @@ namespace geom {
 namespace geom3d {
 
 
+// Final, so that kernels templated on Mesh call accessors without
+// virtual dispatch. MeshGeneric remains the interface for generic code.
 template <class Scal>
-class MeshStructured : public MeshGeneric<Scal, 3> {
+class MeshStructured final : public MeshGeneric<Scal, 3> {
  public:
   static constexpr size_t dim = 3;
   using Vect = geom::Vect<Scal, dim>;
@@ -40,10 +42,13 @@ class MeshStructured : public MeshGeneric<Scal, 3> {
   BlockFaces b_faces_;
   FieldCell<Vect> fc_center_;
   FieldCell<Scal> fc_volume_;
+  // Bucket grid of cell centers, shared by copies of the mesh
+  std::shared_ptr<const BucketGrid<Scal, 3>> center_grid_;
   FieldFace<Vect> ff_center_;
   FieldFace<Scal> ff_area_;
   FieldFace<Vect> ff_surface_;
   std::array<IntIdx, kCellNumNeighbourFaces> cell_neighbour_cell_offset_;
+  FieldCell<std::array<IdxCell, kCellNumNeighbourFaces>> fc_neighbour_cell_;
   FieldCell<std::array<IdxFace, kCellNumNeighbourFaces>> fc_neighbour_face_;
   FieldCell<IdxNode> fc_neighbour_node_base_;
   std::array<IntIdx, kCellNumNeighbourNodes> cell_neighbour_node_offset_;
@@ -55,10 +60,18 @@ class MeshStructured : public MeshGeneric<Scal, 3> {
   FieldFace<bool> ff_is_inner_;
   FieldCell<bool> fc_is_excluded_;
   FieldFace<bool> ff_is_excluded_;
+  RangeList<IdxCell> inner_cells_;
+  RangeList<IdxCell> boundary_cells_;
+  RangeList<IdxCell> active_cells_;
+  RangeList<IdxFace> inner_faces_;
+  RangeList<IdxFace> boundary_faces_;
 
  public:
   MeshStructured() {}
-  MeshStructured(const BlockNodes& b_nodes, const FieldNode<Vect>& fn_node);
+  // tile: size of tiles for numbering of cells and faces
+  // (lexicographic if zero)
+  MeshStructured(const BlockNodes& b_nodes, FieldNode<Vect> fn_node,
+                 MIdx tile = MIdx(0));
   const BlockCells& GetBlockCells() const {
     return b_cells_;
   }
@@ -71,6 +84,10 @@ class MeshStructured : public MeshGeneric<Scal, 3> {
   Vect GetCenter(IdxCell idx) const override {
     return fc_center_[idx];
   }
+  // Cell with the nearest center
+  IdxCell FindNearestCell(Vect point) const override {
+    return IdxCell(center_grid_->FindNearest(point));
+  }
   Vect GetCenter(IdxFace idx) const override {
     return ff_center_[idx];
   }
@@ -95,23 +112,22 @@ class MeshStructured : public MeshGeneric<Scal, 3> {
   size_t GetNumNodes() const override {
     return b_nodes_.size();
   }
+  // Shadow MeshGeneric::Cells() etc. which call GetNum*() virtually
+  Range<IdxCell> Cells() const {
+    return Range<IdxCell>(0, b_cells_.size());
+  }
+  Range<IdxFace> Faces() const {
+    return Range<IdxFace>(0, b_faces_.size());
+  }
+  Range<IdxNode> Nodes() const {
+    return Range<IdxNode>(0, b_nodes_.size());
+  }
+  Vect GetNormal(IdxFace idxface) const override {
+    return ff_surface_[idxface] / ff_area_[idxface];
+  }
   // n = 0 .. 7
   IdxCell GetNeighbourCell(IdxCell idx, size_t n) const override {
-    if (fc_is_inner_[idx]) {
-      idx.AddRaw(cell_neighbour_cell_offset_[n]);
-    } else {
-      MIdx base = b_cells_.GetMIdx(idx);
-      MIdx offset = (std::vector<MIdx>{
-        MIdx{-1, 0, 0}, MIdx{1, 0, 0},
-        MIdx{0, -1, 0}, MIdx{0, 1, 0},
-        MIdx{0, 0, -1}, MIdx{0, 0, 1}})[n];
-      if (b_cells_.IsInside(base + offset)) {
-        idx.AddRaw(cell_neighbour_cell_offset_[n]);
-      } else {
-        idx = IdxCell::None();
-      }
-    }
-    return idx;
+    return fc_neighbour_cell_[idx][n];
   }
   // n same as for GetNeighbourCell()
   IdxFace GetNeighbourFace(IdxCell idxcell, size_t n) const override {
@@ -206,6 +222,27 @@ class MeshStructured : public MeshGeneric<Scal, 3> {
         ff_is_excluded_[idxface] = true;
       }
     }
+    UpdateRanges();
+  }
+  // Cells with IsInner()
+  const RangeList<IdxCell>& InnerCells() const {
+    return inner_cells_;
+  }
+  // Cells neither inner nor excluded
+  const RangeList<IdxCell>& BoundaryCells() const {
+    return boundary_cells_;
+  }
+  // Cells not excluded
+  const RangeList<IdxCell>& ActiveCells() const {
+    return active_cells_;
+  }
+  // Faces with two neighbour cells
+  const RangeList<IdxFace>& InnerFaces() const {
+    return inner_faces_;
+  }
+  // Faces with one neighbour cell
+  const RangeList<IdxFace>& BoundaryFaces() const {
+    return boundary_faces_;
   }
   bool IsExcluded(IdxCell idxcell) const {
     return fc_is_excluded_[idxcell];
@@ -215,6 +252,41 @@ class MeshStructured : public MeshGeneric<Scal, 3> {
   }
 
  private:
+  // Runs of inner and boundary cells and faces
+  void UpdateRanges() {
+    inner_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return fc_is_inner_[c]; });
+    boundary_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return !fc_is_inner_[c] && !fc_is_excluded_[c]; });
+    active_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return !fc_is_excluded_[c]; });
+    inner_faces_ = RangeList<IdxFace>(b_faces_.size(), [this](IdxFace f) {
+        return ff_is_inner_[f]; });
+    boundary_faces_ = RangeList<IdxFace>(b_faces_.size(), [this](IdxFace f) {
+        return !ff_is_inner_[f] && !ff_is_excluded_[f]; });
+  }
+  // Neighbour cell through face n, None if outside the block
+  IdxCell CalcNeighbourCell(IdxCell idx, size_t n) const {
+    MIdx offset(0);
+    offset[n / 2] = (n % 2 == 0 ? -1 : 1);
+    if (IsTile(b_cells_.GetTile())) {
+      // Offsets are not constant with tiled numbering
+      MIdx midx = b_cells_.GetMIdx(idx) + offset;
+      return b_cells_.IsInside(midx) ?
+          b_cells_.GetIdx(midx) : IdxCell::None();
+    }
+    if (fc_is_inner_[idx]) {
+      idx.AddRaw(cell_neighbour_cell_offset_[n]);
+    } else {
+      if (b_cells_.IsInside(b_cells_.GetMIdx(idx) + offset)) {
+        idx.AddRaw(cell_neighbour_cell_offset_[n]);
+      } else {
+        idx = IdxCell::None();
+      }
+    }
+    return idx;
+  }
+
    Vect CalcCenter(IdxCell idxcell) const {
      Vect res = Vect::kZero;
      for (size_t i = 0; i < GetNumNeighbourNodes(idxcell); ++i) {
@@ -263,16 +335,18 @@ class MeshStructured : public MeshGeneric<Scal, 3> {
 
 template <class Scal>
 MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
-                                     const FieldNode<Vect>& fn_node)
+                                     FieldNode<Vect> fn_node,
+                                     MIdx tile)
     : b_nodes_(b_nodes)
-    , fn_node_(fn_node)
-    , b_cells_(b_nodes_.GetBegin(), b_nodes_.GetDimensions() - MIdx(1))
-    , b_faces_(b_cells_.GetDimensions())
+    , fn_node_(std::move(fn_node))
+    , b_cells_(b_nodes_.GetBegin(), b_nodes_.GetDimensions() - MIdx(1), tile)
+    , b_faces_(b_cells_.GetDimensions(), tile)
     , fc_center_(b_cells_)
     , fc_volume_(b_cells_)
     , ff_center_(b_faces_)
     , ff_area_(b_faces_)
     , ff_surface_(b_faces_)
+    , fc_neighbour_cell_(b_cells_)
     , fc_neighbour_face_(b_cells_)
     , fc_neighbour_node_base_(b_cells_)
     , ff_direction_(b_faces_)
@@ -286,9 +360,13 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
 {
   MIdx mb = b_cells_.GetBegin(), me = b_cells_.GetEnd();
 
+  // Loops below are independent over elements and run in parallel
+
   // Base for cell neighbours
-  for (auto midx : b_cells_) {
-    IdxCell idxcell(b_cells_.GetIdx(midx));
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idxcell(raw);
+    MIdx midx = mb + b_cells_.GetMIdx(idxcell);
     fc_neighbour_node_base_[idxcell] = b_nodes_.GetIdx(midx);
 
     auto nface = [this, midx](IntIdx i, IntIdx j, IntIdx k, Direction dir) {
@@ -301,7 +379,13 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
         nface(0, 1, 0, Direction::j),
         nface(0, 0, 0, Direction::k),
         nface(0, 0, 1, Direction::k)}};
+  }
 
+  // Mark inner cells.
+  // Serial: bool fields pack bits, parallel writes would race
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idxcell(raw);
+    MIdx midx = mb + b_cells_.GetMIdx(idxcell);
     fc_is_inner_[idxcell] = (mb < midx && midx + MIdx(1) < me);
     #ifdef PERX
     // adhoc for periodic in x
@@ -329,6 +413,15 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
                                   offset(0, 0, -1), offset(0, 0, 1)}};
   }
 
+  // Neighbour cells of cells
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idxcell(raw);
+    for (size_t n = 0; n < kCellNumNeighbourFaces; ++n) {
+      fc_neighbour_cell_[idxcell][n] = CalcNeighbourCell(idxcell, n);
+    }
+  }
+
   // Offset for cell neighbour nodes
   {
     auto offset = [this](IntIdx i, IntIdx j, IntIdx k) {
@@ -344,7 +437,10 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
 
   // Base for i-face and j-face neighbours
   for (Direction dir : {Direction::i, Direction::j, Direction::k}) {
-    for (auto midx : BlockCells(mb, me - mb + dir)) {
+    BlockCells bf(me - mb + dir);
+#pragma omp parallel for
+    for (IntIdx raw = 0; raw < IntIdx(bf.size()); ++raw) {
+      MIdx midx = mb + bf.GetMIdx(IdxCell(raw));
       IdxFace idxface = b_faces_.GetIdx(midx, dir);
       ff_direction_[idxface] = dir;
       ff_neighbour_cell_[idxface] = {{
@@ -398,21 +494,31 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
   }
 
   // Face centers, area
-  for (auto idx : this->Faces()) {
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_faces_.size()); ++raw) {
+    IdxFace idx(raw);
     ff_center_[idx] = CalcCenter(idx);
     ff_area_[idx] = CalcArea(idx);
     ff_surface_[idx] = CalcSurface(idx);
   }
 
   // Cell centers, volume
-  for (auto idx : this->Cells()) {
+#pragma omp parallel for
+  for (IntIdx raw = 0; raw < IntIdx(b_cells_.size()); ++raw) {
+    IdxCell idx(raw);
     fc_center_[idx] = CalcCenter(idx);
     fc_volume_[idx] = CalcVolume(idx);
   }
+  center_grid_ = std::make_shared<const BucketGrid<Scal, 3>>(
+      std::vector<Vect>(fc_center_.data(),
+                        fc_center_.data() + fc_center_.size()));
 
   // Vect to cell
   for (Direction dir : {Direction::i, Direction::j, Direction::k}) {
-    for (auto midx : BlockCells(mb, me - mb + dir)) {
+    BlockCells bf(me - mb + dir);
+#pragma omp parallel for
+    for (IntIdx raw = 0; raw < IntIdx(bf.size()); ++raw) {
+      MIdx midx = mb + bf.GetMIdx(IdxCell(raw));
       IdxFace idxface = b_faces_.GetIdx(midx, dir);
       IdxCell c;
       c = GetNeighbourCell(idxface, 0);
@@ -452,11 +558,14 @@ MeshStructured<Scal>::MeshStructured(const BlockNodes& b_nodes,
     }
   }
 
-  // Mark inner faces
-  for (auto idxface : this->Faces()) {
+  // Mark inner faces (serial, as for cells)
+  for (IntIdx raw = 0; raw < IntIdx(b_faces_.size()); ++raw) {
+    IdxFace idxface(raw);
     ff_is_inner_[idxface] = (!GetNeighbourCell(idxface, 0).IsNone() &&
         !GetNeighbourCell(idxface, 1).IsNone());
   }
+
+  UpdateRanges();
 }
 
 } // namespace geom2d
@@ -0,0 +1,414 @@
+/*
+ * mesh_uniform.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Petr Karnakov (petr.karnakov@gmail.com)
+ */
+
+#pragma once
+
+#include "mesh.hpp"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+namespace geom {
+
+// Node ordering consistent with geom2d/geom3d::MeshStructured
+template <size_t dim>
+struct UniformNodeOrder;
+
+template <>
+struct UniformNodeOrder<2> {
+  using MIdx = MIdxGeneral<2>;
+  static std::vector<MIdx> GetCellNodes() {
+    return {MIdx(0, 0), MIdx(1, 0), MIdx(1, 1), MIdx(0, 1)};
+  }
+  static std::vector<MIdx> GetFaceNodes(size_t dir) {
+    if (dir == 0) {
+      return {MIdx(0, 0), MIdx(0, 1)};
+    }
+    return {MIdx(1, 0), MIdx(0, 0)};
+  }
+};
+
+template <>
+struct UniformNodeOrder<3> {
+  using MIdx = MIdxGeneral<3>;
+  static std::vector<MIdx> GetCellNodes() {
+    return {MIdx(0, 0, 0), MIdx(1, 0, 0), MIdx(0, 1, 0), MIdx(1, 1, 0),
+            MIdx(0, 0, 1), MIdx(1, 0, 1), MIdx(0, 1, 1), MIdx(1, 1, 1)};
+  }
+  static std::vector<MIdx> GetFaceNodes(size_t dir) {
+    if (dir == 0) {
+      return {MIdx(0, 0, 0), MIdx(0, 1, 0), MIdx(0, 1, 1), MIdx(0, 0, 1)};
+    } else if (dir == 1) {
+      return {MIdx(0, 0, 0), MIdx(0, 0, 1), MIdx(1, 0, 1), MIdx(1, 0, 0)};
+    }
+    return {MIdx(0, 0, 0), MIdx(1, 0, 0), MIdx(1, 1, 0), MIdx(0, 1, 0)};
+  }
+};
+
+// Uniform Cartesian mesh. Same interface and element numbering
+// as MeshStructured but geometry (centers, volumes, areas, surfaces, nodes)
+// is computed from the multi-index and the mesh step.
+// Only connectivity and flags are stored.
+// Periodic adhoc conditions (PERX, PERY, PERZ) are not supported.
+template <class ScalArg, size_t dimArg>
+class MeshUniform final : public MeshGeneric<ScalArg, dimArg> {
+ public:
+  using Scal = ScalArg;
+  static constexpr size_t dim = dimArg;
+  using Vect = geom::Vect<Scal, dim>;
+  using Direction = geom::Direction<dim>;
+  using MIdx = geom::Vect<IntIdx, dim>;
+  using BlockNodes = geom::BlockNodes<dim>;
+  using BlockCells = geom::BlockCells<dim>;
+  using BlockFaces = geom::BlockFaces<dim>;
+  static constexpr size_t kCellNumNeighbourFaces = 2 * dim;
+  static constexpr size_t kCellNumNeighbourNodes = size_t(1) << dim;
+  static constexpr size_t kFaceNumNeighbourNodes = size_t(1) << (dim - 1);
+  static constexpr size_t kFaceNumNeighbourCells = 2;
+
+ private:
+  BlockNodes b_nodes_;
+  BlockCells b_cells_;
+  BlockFaces b_faces_;
+  Vect origin_; // position of the first node
+  Vect h_;      // mesh step
+  Scal volume_;
+  Vect area_;   // face area for each direction
+  std::array<size_t, dim + 1> face_begin_; // first face of each direction
+  std::array<MIdx, dim> face_size_; // faces block size for each direction
+  std::array<MIdx, kCellNumNeighbourNodes> cell_neighbour_node_offset_;
+  std::array<std::array<MIdx, kFaceNumNeighbourNodes>, dim>
+  face_neighbour_node_offset_;
+  FieldCell<std::array<IdxCell, kCellNumNeighbourFaces>> fc_neighbour_cell_;
+  FieldCell<std::array<IdxFace, kCellNumNeighbourFaces>> fc_neighbour_face_;
+  FieldFace<std::array<IdxCell, kFaceNumNeighbourCells>> ff_neighbour_cell_;
+  FieldCell<bool> fc_is_inner_;
+  FieldFace<bool> ff_is_inner_;
+  FieldCell<bool> fc_is_excluded_;
+  FieldFace<bool> ff_is_excluded_;
+  RangeList<IdxCell> inner_cells_;
+  RangeList<IdxCell> boundary_cells_;
+  RangeList<IdxCell> active_cells_;
+  RangeList<IdxFace> inner_faces_;
+  RangeList<IdxFace> boundary_faces_;
+
+ public:
+  MeshUniform() {}
+  // Nodes fn_node must form a uniform grid.
+  // tile: size of tiles for numbering of cells and faces
+  // (lexicographic if zero)
+  MeshUniform(const BlockNodes& b_nodes, const FieldNode<Vect>& fn_node,
+              MIdx tile = MIdx(0));
+  const BlockCells& GetBlockCells() const {
+    return b_cells_;
+  }
+  const BlockFaces& GetBlockFaces() const {
+    return b_faces_;
+  }
+  const BlockNodes& GetBlockNodes() const {
+    return b_nodes_;
+  }
+  Vect GetMeshStep() const {
+    return h_;
+  }
+  Vect GetCenter(IdxCell idx) const override {
+    return origin_ + (Vect(b_cells_.GetMIdx(idx)) + Vect(0.5)) * h_;
+  }
+  Vect GetCenter(IdxFace idx) const override {
+    size_t d = GetDirection(idx);
+    Vect r = Vect(GetFaceMIdx(idx, d)) + Vect(0.5);
+    r[d] -= 0.5;
+    return origin_ + r * h_;
+  }
+  Vect GetSurface(IdxFace idx) const override {
+    size_t d = GetDirection(idx);
+    Vect res = Vect::kZero;
+    res[d] = area_[d];
+    return res;
+  }
+  Vect GetNode(IdxNode idx) const override {
+    return origin_ + Vect(b_nodes_.GetMIdx(idx)) * h_;
+  }
+  Scal GetVolume(IdxCell) const override {
+    return volume_;
+  }
+  Scal GetArea(IdxFace idx) const override {
+    return area_[GetDirection(idx)];
+  }
+  size_t GetNumCells() const override {
+    return b_cells_.size();
+  }
+  size_t GetNumFaces() const override {
+    return b_faces_.size();
+  }
+  size_t GetNumNodes() const override {
+    return b_nodes_.size();
+  }
+  Range<IdxCell> Cells() const {
+    return Range<IdxCell>(0, b_cells_.size());
+  }
+  Range<IdxFace> Faces() const {
+    return Range<IdxFace>(0, b_faces_.size());
+  }
+  Range<IdxNode> Nodes() const {
+    return Range<IdxNode>(0, b_nodes_.size());
+  }
+  Vect GetNormal(IdxFace idx) const override {
+    Vect res = Vect::kZero;
+    res[GetDirection(idx)] = 1.;
+    return res;
+  }
+  IdxCell GetNeighbourCell(IdxCell idx, size_t n) const override {
+    return fc_neighbour_cell_[idx][n];
+  }
+  IdxFace GetNeighbourFace(IdxCell idx, size_t n) const override {
+    return fc_neighbour_face_[idx][n];
+  }
+  Scal GetOutwardFactor(IdxCell, size_t n) const override {
+    return (n % 2 == 0 ? -1. : 1.);
+  }
+  Vect GetOutwardSurface(IdxCell idxcell, size_t n) const override {
+    Vect res = Vect::kZero;
+    res[n / 2] = area_[n / 2] * GetOutwardFactor(idxcell, n);
+    return res;
+  }
+  IdxNode GetNeighbourNode(IdxCell idx, size_t n) const override {
+    return b_nodes_.GetIdx(b_nodes_.GetBegin() + b_cells_.GetMIdx(idx) +
+                           cell_neighbour_node_offset_[n]);
+  }
+  Direction GetDirection(IdxFace idx) const {
+    size_t d = 0;
+    while (d + 1 < dim && idx.GetRaw() >= face_begin_[d + 1]) {
+      ++d;
+    }
+    return Direction(d);
+  }
+  IdxCell GetNeighbourCell(IdxFace idx, size_t n) const override {
+    return ff_neighbour_cell_[idx][n];
+  }
+  Vect GetVectToCell(IdxFace idx, size_t n) const {
+    size_t d = GetDirection(idx);
+    Vect res = Vect::kZero;
+    res[d] = (n == 0 ? -0.5 : 0.5) * h_[d];
+    return res;
+  }
+  IdxNode GetNeighbourNode(IdxFace idx, size_t n) const override {
+    size_t d = GetDirection(idx);
+    return b_nodes_.GetIdx(b_nodes_.GetBegin() + GetFaceMIdx(idx, d) +
+                           face_neighbour_node_offset_[d][n]);
+  }
+  size_t GetNumNeighbourFaces(IdxCell) const override {
+    return kCellNumNeighbourFaces;
+  }
+  size_t GetNumNeighbourNodes(IdxCell) const override {
+    return kCellNumNeighbourNodes;
+  }
+  size_t GetNumNeighbourCells(IdxFace) const override {
+    return kFaceNumNeighbourCells;
+  }
+  size_t GetNumNeighbourNodes(IdxFace) const override {
+    return kFaceNumNeighbourNodes;
+  }
+  bool IsInner(IdxCell idxcell) const override {
+    return fc_is_inner_[idxcell];
+  }
+  bool IsInner(IdxFace idxface) const override {
+    return ff_is_inner_[idxface];
+  }
+  bool IsInside(IdxCell idxcell, Vect vect) const override {
+    Vect lb = origin_ + Vect(b_cells_.GetMIdx(idxcell)) * h_;
+    Vect rt = lb + h_;
+    return lb <= vect && vect <= rt;
+  }
+  // Cell containing the point (clipped to the domain)
+  IdxCell FindNearestCell(Vect point) const override {
+    MIdx midx;
+    for (size_t d = 0; d < dim; ++d) {
+      midx[d] = static_cast<IntIdx>(
+          std::floor((point[d] - origin_[d]) / h_[d]));
+    }
+    midx += b_cells_.GetBegin();
+    b_cells_.Cut(midx);
+    return b_cells_.GetIdx(midx);
+  }
+  void ExcludeCells(const std::vector<IdxCell>& list) {
+    for (auto idxcell : list) {
+      fc_is_excluded_[idxcell] = true;
+      fc_is_inner_[idxcell] = false;
+    }
+    for (auto idxface : Faces()) {
+      for (size_t i = 0; i < kFaceNumNeighbourCells; ++i) {
+        IdxCell idxcell = GetNeighbourCell(idxface, i);
+        if (!idxcell.IsNone() && fc_is_excluded_[idxcell]) {
+          ff_is_inner_[idxface] = false;
+          ff_neighbour_cell_[idxface][i] = IdxCell::None();
+        }
+      }
+    }
+    for (auto idxface : Faces()) {
+      bool found_valid = false;
+      for (size_t i = 0; i < kFaceNumNeighbourCells; ++i) {
+        if (!GetNeighbourCell(idxface, i).IsNone()) {
+          found_valid = true;
+        }
+      }
+      if (!found_valid) {
+        ff_is_excluded_[idxface] = true;
+      }
+    }
+    UpdateRanges();
+  }
+  // Cells with IsInner()
+  const RangeList<IdxCell>& InnerCells() const {
+    return inner_cells_;
+  }
+  // Cells neither inner nor excluded
+  const RangeList<IdxCell>& BoundaryCells() const {
+    return boundary_cells_;
+  }
+  // Cells not excluded
+  const RangeList<IdxCell>& ActiveCells() const {
+    return active_cells_;
+  }
+  // Faces with two neighbour cells
+  const RangeList<IdxFace>& InnerFaces() const {
+    return inner_faces_;
+  }
+  // Faces with one neighbour cell
+  const RangeList<IdxFace>& BoundaryFaces() const {
+    return boundary_faces_;
+  }
+  bool IsExcluded(IdxCell idxcell) const {
+    return fc_is_excluded_[idxcell];
+  }
+  bool IsExcluded(IdxFace idxface) const {
+    return ff_is_excluded_[idxface];
+  }
+
+ private:
+  // Runs of inner and boundary cells and faces
+  void UpdateRanges() {
+    inner_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return fc_is_inner_[c]; });
+    boundary_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return !fc_is_inner_[c] && !fc_is_excluded_[c]; });
+    active_cells_ = RangeList<IdxCell>(b_cells_.size(), [this](IdxCell c) {
+        return !fc_is_excluded_[c]; });
+    inner_faces_ = RangeList<IdxFace>(b_faces_.size(), [this](IdxFace f) {
+        return ff_is_inner_[f]; });
+    boundary_faces_ = RangeList<IdxFace>(b_faces_.size(), [this](IdxFace f) {
+        return !ff_is_inner_[f] && !ff_is_excluded_[f]; });
+  }
+  // Offset of face from the beginning of its block (direction d)
+  MIdx GetFaceMIdx(IdxFace idx, size_t d) const {
+    size_t raw = idx.GetRaw() - face_begin_[d];
+    if (IsTile(b_cells_.GetTile())) {
+      return GetTiledMIdx(raw, face_size_[d], b_cells_.GetTile());
+    }
+    MIdx midx;
+    for (size_t i = 0; i < dim; ++i) {
+      midx[i] = raw % face_size_[d][i];
+      raw /= face_size_[d][i];
+    }
+    return midx;
+  }
+};
+
+template <class Scal, size_t dim>
+MeshUniform<Scal, dim>::MeshUniform(const BlockNodes& b_nodes,
+                                    const FieldNode<Vect>& fn_node,
+                                    MIdx tile)
+    : b_nodes_(b_nodes)
+    , b_cells_(b_nodes_.GetBegin(), b_nodes_.GetDimensions() - MIdx(1), tile)
+    , b_faces_(b_cells_.GetDimensions(), tile)
+    , fc_neighbour_cell_(b_cells_)
+    , fc_neighbour_face_(b_cells_)
+    , ff_neighbour_cell_(b_faces_)
+    , fc_is_inner_(b_cells_)
+    , ff_is_inner_(b_faces_)
+    , fc_is_excluded_(b_cells_, false)
+    , ff_is_excluded_(b_faces_, false)
+{
+  MIdx mb = b_cells_.GetBegin(), me = b_cells_.GetEnd();
+
+  // Geometry
+  origin_ = fn_node[b_nodes_.GetIdx(mb)];
+  h_ = (fn_node[b_nodes_.GetIdx(me)] - origin_) /
+      Vect(b_cells_.GetDimensions());
+  volume_ = 1.;
+  for (size_t d = 0; d < dim; ++d) {
+    volume_ *= h_[d];
+  }
+  for (size_t d = 0; d < dim; ++d) {
+    area_[d] = volume_ / h_[d];
+  }
+  for (auto idxnode : Nodes()) {
+    if (GetNode(idxnode).dist(fn_node[idxnode]) > 1e-6 * h_.norm()) {
+      throw std::runtime_error("MeshUniform: non-uniform nodes");
+    }
+  }
+
+  // Faces block of each direction
+  face_begin_[0] = 0;
+  for (size_t d = 0; d < dim; ++d) {
+    face_size_[d] = b_cells_.GetDimensions();
+    ++face_size_[d][d];
+    size_t n = 1;
+    for (size_t i = 0; i < dim; ++i) {
+      n *= face_size_[d][i];
+    }
+    face_begin_[d + 1] = face_begin_[d] + n;
+  }
+
+  // Node offsets
+  {
+    auto v = UniformNodeOrder<dim>::GetCellNodes();
+    std::copy(v.begin(), v.end(), cell_neighbour_node_offset_.begin());
+    for (size_t d = 0; d < dim; ++d) {
+      auto v = UniformNodeOrder<dim>::GetFaceNodes(d);
+      std::copy(v.begin(), v.end(), face_neighbour_node_offset_[d].begin());
+    }
+  }
+
+  // Cell neighbours
+  for (auto midx : b_cells_) {
+    IdxCell idxcell(b_cells_.GetIdx(midx));
+    for (size_t n = 0; n < kCellNumNeighbourFaces; ++n) {
+      Direction dir(n / 2);
+      MIdx offset = dir;
+      fc_neighbour_face_[idxcell][n] =
+          b_faces_.GetIdx(n % 2 == 0 ? midx : midx + offset, dir);
+      MIdx midx_cell = (n % 2 == 0 ? midx - offset : midx + offset);
+      fc_neighbour_cell_[idxcell][n] = (b_cells_.IsInside(midx_cell) ?
+          b_cells_.GetIdx(midx_cell) : IdxCell::None());
+    }
+    fc_is_inner_[idxcell] = (mb < midx && midx + MIdx(1) < me);
+  }
+
+  // Face neighbours
+  for (size_t d = 0; d < dim; ++d) {
+    Direction dir(d);
+    for (auto midx : BlockCells(mb, me - mb + dir)) {
+      IdxFace idxface = b_faces_.GetIdx(midx, dir);
+      ff_neighbour_cell_[idxface] = {{
+          b_cells_.GetIdx(midx - dir),
+          b_cells_.GetIdx(midx)}};
+      if (midx[dir] == mb[dir]) {
+        ff_neighbour_cell_[idxface][0] = IdxCell::None();
+      }
+      if (midx[dir] == me[dir]) {
+        ff_neighbour_cell_[idxface][1] = IdxCell::None();
+      }
+      ff_is_inner_[idxface] = (!ff_neighbour_cell_[idxface][0].IsNone() &&
+          !ff_neighbour_cell_[idxface][1].IsNone());
+    }
+  }
+
+  UpdateRanges();
+}
+
+} // namespace geom
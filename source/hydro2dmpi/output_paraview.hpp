@@ -57,8 +57,10 @@ class SessionParaviewStructured : public SessionParaview {
     auto& field = entry->GetField();
 
     WriteDataArrayHeader(out, entry->GetName(), 1);
-    for (auto idxcell : mesh.Cells()) {
-      out << field[idxcell] << " ";
+    // Lexicographic order regardless of numbering of cells
+    auto& bc = mesh.GetBlockCells();
+    for (auto midx : bc) {
+      out << field[bc.GetIdx(midx)] << " ";
     }
     out << "\n";
     WriteDataArrayFooter(out);
@@ -42,7 +42,7 @@ class ParticleSystem : public UnsteadySolver {
 
   const Mesh& mesh;
 
-  geom::SearchMesh<Mesh> search_mesh_;
+  geom::LocatorStructured<Mesh> locator_;
 
   const Scal kSpawningGapRelative;
   const Scal kParticleRadiusFactor;
@@ -105,7 +105,7 @@ class ParticleSystem : public UnsteadySolver {
     IdxParticle idxpart(fp_position_.size());
     fp_position_.push_back(position);
     particles_ = geom::Range<IdxParticle>(0, fp_position_.size());
-    fp_velocity_.push_back(Vect());
+    fp_velocity_.push_back(Vect::kZero);
     fp_cell_.push_back(idxcell);
     fp_cell_center_distance_.push_back(position.dist(mesh.GetCenter(idxcell)));
     fp_is_removed_.push_back(false);
@@ -146,7 +146,7 @@ class ParticleSystem : public UnsteadySolver {
         const Vect particle_position = fp_position_[idxpart];
         auto oldcell = fp_cell_[idxpart];
         if (!mesh.IsInside(oldcell, particle_position)) {
-          IdxCell newcell = search_mesh_.FindCell(particle_position);
+          IdxCell newcell = locator_.FindCell(particle_position);
           if (newcell == IdxCell::None()) {
             fp_is_removed_[idxpart] = true;
           } else {
@@ -208,7 +208,7 @@ class ParticleSystem : public UnsteadySolver {
     RestoreConsistency();
     for (auto idxpart : particles_) {
       IdxCell idxcell = fp_cell_[idxpart];
-      std::array<IdxNode, 4> nodes;
+      std::array<IdxNode, Mesh::kCellNumNeighbourNodes> nodes;
       for (size_t i = 0; i < mesh.GetNumNeighbourNodes(idxcell); ++i) {
         nodes[i] = mesh.GetNeighbourNode(idxcell, i);
       }
@@ -309,9 +309,7 @@ class ParticleSystem : public UnsteadySolver {
 
     for (auto idxpart : particles_) {
       if (!fp_is_removed_[idxpart]) {
-        auto nearby_cells = search_mesh_.GetNearbyCells(
-            fp_position_[idxpart], particle_radius);
-        for (auto idxcell : nearby_cells) {
+        auto add = [&](IdxCell idxcell) {
           fc_particle_weight_sum_[idxcell] +=
               weight(mesh.GetCenter(idxcell), fp_position_[idxpart]);
 
@@ -319,7 +317,8 @@ class ParticleSystem : public UnsteadySolver {
             fc_fields_[n][idxcell] += fp_fields_[n][idxpart] *
                 weight(mesh.GetCenter(idxcell), fp_position_[idxpart]);
           }
-        }
+        };
+        locator_.ForNearbyCells(fp_position_[idxpart], particle_radius, add);
 
       }
     }
@@ -362,7 +361,7 @@ class ParticleSystem : public UnsteadySolver {
                  Scal back_relaxation_factor = 1.)
       : UnsteadySolver(time, time_step)
       , mesh(mesh)
-      , search_mesh_(mesh, 4, mesh.GetNumCells() * 16, 1)
+      , locator_(mesh)
       , kSpawningGapRelative(spawning_gap_relative)
       , kParticleRadiusFactor(particle_radius_factor)
       , kMinNumParticlesInCell(min_num_particle_in_cell)
@@ -11,6 +11,8 @@
 #include "linear.hpp"
 #include <exception>
 #include <memory>
+#include <initializer_list>
+#include <utility>
 
 using geom::IntIdx;
 
@@ -341,9 +343,9 @@ class DerivativeBoundaryFacePlain:
 };
 
 template <class T, class Mesh>
-geom::FieldFace<T> Interpolate(const geom::FieldNode<T>& fn_u,
-                               const Mesh& mesh) {
-  geom::FieldFace<T> res(mesh);
+void Interpolate(const geom::FieldNode<T>& fn_u,
+                 const Mesh& mesh, geom::FieldFace<T>& res) {
+  res.Reinit(mesh);
 
   for (auto idxface : mesh.Faces()) {
     T sum = static_cast<T>(0);
@@ -352,7 +354,13 @@ geom::FieldFace<T> Interpolate(const geom::FieldNode<T>& fn_u,
     }
     res[idxface] = sum / mesh.GetNumNeighbourNodes(idxface);
   }
+}
 
+template <class T, class Mesh>
+geom::FieldFace<T> Interpolate(const geom::FieldNode<T>& fn_u,
+                               const Mesh& mesh) {
+  geom::FieldFace<T> res;
+  Interpolate(fn_u, mesh, res);
   return res;
 }
 
@@ -372,6 +380,18 @@ T GetInterpolatedInner(const geom::FieldCell<T>& fc_u,
   return fc_u[cm] * (1. - alpha) + fc_u[cp] * alpha;
 }
 
+// Component n of multi-component field
+template <class T, size_t N, class Mesh>
+T GetInterpolatedInner(const geom::FieldCellMulti<T, N>& fcm_u, size_t n,
+                       IdxFace idxface,
+                       const Mesh& mesh) {
+  using Scal = typename Mesh::Scal;
+  IdxCell cm = mesh.GetNeighbourCell(idxface, 0);
+  IdxCell cp = mesh.GetNeighbourCell(idxface, 1);
+  Scal alpha = 0.5;
+  return fcm_u[cm][n] * (1. - alpha) + fcm_u[cp][n] * alpha;
+}
+
 template <class Scal>
 Scal GetGeometricAverage(Scal a, Scal b) {
   return std::sqrt(a * b);
@@ -389,33 +409,34 @@ geom::Vect<Scal, dim> GetGeometricAverage(const geom::Vect<Scal, dim>& a,
   return direction * std::sqrt(a.norm() * b.norm());
 }
 
+// Interpolation on inner faces, zero on other faces.
+// Result in res, which must not be fc_u
 template <class T, class Mesh>
-geom::FieldFace<T> Interpolate(
-    const geom::FieldCell<T>& fc_u,
-    const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond_u,
-    const Mesh& mesh, bool geometric = false) {
+void InterpolateInner(const geom::FieldCell<T>& fc_u, const Mesh& mesh,
+                      geom::FieldFace<T>& res, bool geometric = false) {
   using Scal = typename Mesh::Scal;
-  using Vect = typename Mesh::Vect;
   using IdxCell = geom::IdxCell;
   using IdxFace = geom::IdxFace;
 
-  geom::FieldFace<T> res(mesh, T(0)); // Valid value essential for extrapolation
+  res.Reinit(mesh, T(0)); // Valid value essential for extrapolation
 
   if (geometric) {
-#pragma omp parallel for
-    for (IntIdx i = 0; i < static_cast<IntIdx>(mesh.Faces().size()); ++i) {
-      IdxFace idxface(i);
-      if (mesh.IsInner(idxface)) {
+#pragma omp parallel
+    for (auto& run : mesh.InnerFaces().GetRuns()) {
+#pragma omp for nowait
+      for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+        IdxFace idxface(i);
         IdxCell cm = mesh.GetNeighbourCell(idxface, 0);
         IdxCell cp = mesh.GetNeighbourCell(idxface, 1);
         res[idxface] = GetGeometricAverage(fc_u[cm], fc_u[cp]);
       }
     }
   } else {
-#pragma omp parallel for
-    for (IntIdx i = 0; i < static_cast<IntIdx>(mesh.Faces().size()); ++i) {
-      IdxFace idxface(i);
-      if (mesh.IsInner(idxface)) {
+#pragma omp parallel
+    for (auto& run : mesh.InnerFaces().GetRuns()) {
+#pragma omp for nowait
+      for (IntIdx i = run.GetBegin(); i < IntIdx(run.GetEnd()); ++i) {
+        IdxFace idxface(i);
         IdxCell cm = mesh.GetNeighbourCell(idxface, 0);
         IdxCell cp = mesh.GetNeighbourCell(idxface, 1);
         //Vect xf = mesh.GetCenter(idxface);
@@ -427,6 +448,20 @@ geom::FieldFace<T> Interpolate(
       }
     }
   }
+}
+
+// Result in res, which must not be fc_u
+template <class T, class Mesh>
+void Interpolate(
+    const geom::FieldCell<T>& fc_u,
+    const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond_u,
+    const Mesh& mesh, geom::FieldFace<T>& res, bool geometric = false) {
+  using Scal = typename Mesh::Scal;
+  using Vect = typename Mesh::Vect;
+  using IdxCell = geom::IdxCell;
+  using IdxFace = geom::IdxFace;
+
+  InterpolateInner(fc_u, mesh, res, geometric);
 
   for (auto it = mf_cond_u.cbegin(); it != mf_cond_u.cend(); ++it) {
     IdxFace idxface = it->GetIdx();
@@ -466,16 +501,197 @@ geom::FieldFace<T> Interpolate(
       throw std::runtime_error("Unknown boundary condition type");
     }
   }
+}
+
+template <class T, class Mesh>
+geom::FieldFace<T> Interpolate(
+    const geom::FieldCell<T>& fc_u,
+    const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond_u,
+    const Mesh& mesh, bool geometric = false) {
+  geom::FieldFace<T> res;
+  Interpolate(fc_u, mf_cond_u, mesh, res, geometric);
+  return res;
+}
+
+// Conditions on boundary faces compiled into arrays by type
+// with neighbour cells and geometry precomputed, so that kernels
+// make one loop per type without dynamic_cast or map lookups.
+// Compile() again if the set of conditions or the mesh changes,
+// Update() if values of the conditions change.
+// Inner faces are skipped.
+template <class T, class Mesh>
+class ConditionFaceTable {
+  using Scal = typename Mesh::Scal;
+  using Vect = typename Mesh::Vect;
+
+ public:
+  // Given value
+  struct Value {
+    IdxFace idxface;
+    IdxCell idxcell; // neighbour cell
+    Scal dist;       // distance to center of idxcell
+    Scal factor;     // 1 if idxcell is neighbour 0, -1 otherwise
+    T value;
+  };
+  // Given normal derivative
+  struct Derivative {
+    IdxFace idxface;
+    IdxCell idxcell;
+    Scal dist;
+    Scal factor;
+    T derivative;
+  };
+  // Linear extrapolation from idxcell using values on its other faces:
+  // value = (u[idxcell] / dist + sum(u[term.idxface] * term.coeff / volume))
+  //         / den
+  struct Extrapolation {
+    IdxFace idxface;
+    IdxCell idxcell;
+    Scal dist;
+    Scal den;
+    Scal volume;
+    size_t terms_begin;
+    size_t terms_end;
+  };
+  struct Term {
+    IdxFace idxface;
+    Scal coeff; // outward surface dot normal
+  };
+
+  ConditionFaceTable() {}
+  ConditionFaceTable(
+      const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond,
+      const Mesh& mesh) {
+    Compile(mf_cond, mesh);
+  }
+  void Compile(const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond,
+               const Mesh& mesh) {
+    value_.clear();
+    value_cond_.clear();
+    derivative_.clear();
+    derivative_cond_.clear();
+    extrapolation_.clear();
+    terms_.clear();
+    for (auto it = mf_cond.cbegin(); it != mf_cond.cend(); ++it) {
+      IdxFace idxface = it->GetIdx();
+      if (mesh.IsInner(idxface)) {
+        continue;
+      }
+      size_t id = mesh.GetValidNeighbourCellId(idxface);
+      IdxCell idxcell = mesh.GetNeighbourCell(idxface, id);
+      Scal factor = (id == 0 ? 1. : -1.);
+      Scal dist = mesh.GetVectToCell(idxface, id).norm();
+      ConditionFace* cond = it->GetValue().get();
+      if (auto cond_value = dynamic_cast<ConditionFaceValue<T>*>(cond)) {
+        value_.push_back({idxface, idxcell, dist, factor, T(0)});
+        value_cond_.push_back(cond_value);
+      } else if (auto cond_derivative =
+          dynamic_cast<ConditionFaceDerivative<T>*>(cond)) {
+        derivative_.push_back({idxface, idxcell, dist, factor, T(0)});
+        derivative_cond_.push_back(cond_derivative);
+      } else if (dynamic_cast<ConditionFaceExtrapolation*>(cond)) {
+        Vect normal = mesh.GetNormal(idxface) * factor;
+        Scal den = 1. / dist;
+        Scal volume = mesh.GetVolume(idxcell);
+        size_t terms_begin = terms_.size();
+        for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
+          IdxFace nface = mesh.GetNeighbourFace(idxcell, i);
+          Scal coeff = mesh.GetOutwardSurface(idxcell, i).dot(normal);
+          if (nface == idxface) {
+            den -= coeff / volume;
+          } else {
+            terms_.push_back({nface, coeff});
+          }
+        }
+        extrapolation_.push_back(
+            {idxface, idxcell, dist, den, volume, terms_begin, terms_.size()});
+      } else {
+        throw std::runtime_error("Unknown boundary condition type");
+      }
+    }
+    Update();
+  }
+  // Copies values from conditions
+  void Update() {
+    for (size_t i = 0; i < value_.size(); ++i) {
+      value_[i].value = value_cond_[i]->GetValue();
+    }
+    for (size_t i = 0; i < derivative_.size(); ++i) {
+      derivative_[i].derivative = derivative_cond_[i]->GetDerivative();
+    }
+  }
+  const std::vector<Value>& GetValues() const {
+    return value_;
+  }
+  const std::vector<Derivative>& GetDerivatives() const {
+    return derivative_;
+  }
+  const std::vector<Extrapolation>& GetExtrapolations() const {
+    return extrapolation_;
+  }
+  const std::vector<Term>& GetTerms() const {
+    return terms_;
+  }
+
+ private:
+  std::vector<Value> value_;
+  std::vector<const ConditionFaceValue<T>*> value_cond_;
+  std::vector<Derivative> derivative_;
+  std::vector<const ConditionFaceDerivative<T>*> derivative_cond_;
+  std::vector<Extrapolation> extrapolation_;
+  std::vector<Term> terms_;
+};
+
+// Values on boundary faces given by conditions,
+// extrapolation uses values in res on the other faces of the cell.
+template <class T, class Mesh>
+void InterpolateBoundary(const geom::FieldCell<T>& fc_u,
+                         const ConditionFaceTable<T, Mesh>& cond,
+                         geom::FieldFace<T>& res) {
+  using Scal = typename Mesh::Scal;
+  for (auto& e : cond.GetValues()) {
+    res[e.idxface] = e.value;
+  }
+  for (auto& e : cond.GetDerivatives()) {
+    Scal alpha = e.dist * e.factor;
+    res[e.idxface] = fc_u[e.idxcell] + e.derivative * alpha;
+  }
+  auto& terms = cond.GetTerms();
+  for (auto& e : cond.GetExtrapolations()) {
+    T nom = fc_u[e.idxcell] / e.dist;
+    for (size_t j = e.terms_begin; j < e.terms_end; ++j) {
+      nom += res[terms[j].idxface] * terms[j].coeff / e.volume;
+    }
+    res[e.idxface] = nom / e.den;
+  }
+}
+
+// Result in res, which must not be fc_u
+template <class T, class Mesh>
+void Interpolate(const geom::FieldCell<T>& fc_u,
+                 const ConditionFaceTable<T, Mesh>& cond,
+                 const Mesh& mesh, geom::FieldFace<T>& res,
+                 bool geometric = false) {
+  InterpolateInner(fc_u, mesh, res, geometric);
+  InterpolateBoundary(fc_u, cond, res);
+}
+
+template <class T, class Mesh>
+geom::FieldFace<T> Interpolate(const geom::FieldCell<T>& fc_u,
+                               const ConditionFaceTable<T, Mesh>& cond,
+                               const Mesh& mesh, bool geometric = false) {
+  geom::FieldFace<T> res;
+  Interpolate(fc_u, cond, mesh, res, geometric);
   return res;
 }
 
 
 template <class Mesh>
-geom::FieldCell<typename Mesh::Scal>
-CalcLaplacian(const geom::FieldCell<typename Mesh::Scal>& fc_u,
-              const Mesh& mesh) {
+void CalcLaplacian(const geom::FieldCell<typename Mesh::Scal>& fc_u,
+                   const Mesh& mesh,
+                   geom::FieldCell<typename Mesh::Scal>& res) {
   using Scal = typename Mesh::Scal;
-  geom::FieldCell<Scal> res(mesh);
+  res.Reinit(mesh);
 
   for (auto idxcell : mesh.Cells()) {
     Scal sum = 0.;
@@ -493,36 +709,42 @@ CalcLaplacian(const geom::FieldCell<typename Mesh::Scal>& fc_u,
     }
     res[idxcell] = sum / mesh.GetVolume(idxcell);
   }
+}
 
+template <class Mesh>
+geom::FieldCell<typename Mesh::Scal>
+CalcLaplacian(const geom::FieldCell<typename Mesh::Scal>& fc_u,
+              const Mesh& mesh) {
+  geom::FieldCell<typename Mesh::Scal> res;
+  CalcLaplacian(fc_u, mesh, res);
   return res;
 }
 
 template <class T, class Mesh>
-geom::FieldFace<T> InterpolateFirstUpwind(
+void InterpolateFirstUpwind(
     const geom::FieldCell<T>& fc_u,
     const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond_u,
     const geom::FieldFace<typename Mesh::Scal>& probe,
-    const Mesh& mesh, typename Mesh::Scal threshold = 1e-8) {
+    const Mesh& mesh, geom::FieldFace<T>& res,
+    typename Mesh::Scal threshold = 1e-8) {
   using Scal = typename Mesh::Scal;
   using Vect = typename Mesh::Vect;
   using IdxCell = geom::IdxCell;
   using IdxFace = geom::IdxFace;
 
-  geom::FieldFace<T> res(mesh);
+  res.Reinit(mesh, T(0));
 
-  for (IdxFace idxface : mesh.Faces()) {
-     if (mesh.IsInner(idxface)) {
-       IdxCell cm = mesh.GetNeighbourCell(idxface, 0);
-       IdxCell cp = mesh.GetNeighbourCell(idxface, 1);
-       if (probe[idxface] > threshold) {
-         res[idxface] = fc_u[cm];
-       } else if (probe[idxface] < -threshold) {
-         res[idxface] = fc_u[cp];
-       } else {
-         // TODO: Make a CDS proper for non-uniform grids
-         res[idxface] = 0.5 * (fc_u[cm] + fc_u[cp]);
-       }
-     }
+  for (IdxFace idxface : mesh.InnerFaces()) {
+    IdxCell cm = mesh.GetNeighbourCell(idxface, 0);
+    IdxCell cp = mesh.GetNeighbourCell(idxface, 1);
+    if (probe[idxface] > threshold) {
+      res[idxface] = fc_u[cm];
+    } else if (probe[idxface] < -threshold) {
+      res[idxface] = fc_u[cp];
+    } else {
+      // TODO: Make a CDS proper for non-uniform grids
+      res[idxface] = 0.5 * (fc_u[cm] + fc_u[cp]);
+    }
   }
 
   for (auto it = mf_cond_u.cbegin(); it != mf_cond_u.cend(); ++it) {
@@ -544,6 +766,16 @@ geom::FieldFace<T> InterpolateFirstUpwind(
       throw std::runtime_error("Unknown boundary condition type");
     }
   }
+}
+
+template <class T, class Mesh>
+geom::FieldFace<T> InterpolateFirstUpwind(
+    const geom::FieldCell<T>& fc_u,
+    const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond_u,
+    const geom::FieldFace<typename Mesh::Scal>& probe,
+    const Mesh& mesh, typename Mesh::Scal threshold = 1e-8) {
+  geom::FieldFace<T> res;
+  InterpolateFirstUpwind(fc_u, mf_cond_u, probe, mesh, res, threshold);
   return res;
 }
 
@@ -558,41 +790,39 @@ Scal Superbee(Scal p, Scal q) {
 }
 
 template <class Mesh>
-geom::FieldFace<typename Mesh::Scal>
-InterpolateSuperbee(
+void InterpolateSuperbee(
     const geom::FieldCell<typename Mesh::Scal>& fc_u,
     const geom::FieldCell<typename Mesh::Vect>& fc_u_grad,
     const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond_u,
     const geom::FieldFace<typename Mesh::Scal>& probe,
-    const Mesh& mesh, typename Mesh::Scal threshold = 1e-8) {
+    const Mesh& mesh, geom::FieldFace<typename Mesh::Scal>& res,
+    typename Mesh::Scal threshold = 1e-8) {
   using Scal = typename Mesh::Scal;
   using Vect = typename Mesh::Vect;
   using IdxCell = geom::IdxCell;
   using IdxFace = geom::IdxFace;
 
-  geom::FieldFace<Scal> res(mesh);
-
-  for (IdxFace idxface : mesh.Faces()) {
-     if (mesh.IsInner(idxface)) {
-       IdxCell P = mesh.GetNeighbourCell(idxface, 0);
-       IdxCell E = mesh.GetNeighbourCell(idxface, 1);
-       Vect rp = mesh.GetVectToCell(idxface, 0); 
-       Vect re = mesh.GetVectToCell(idxface, 1); 
-       const auto& u = fc_u;
-       const auto& g = fc_u_grad;
-       if (probe[idxface] > threshold) {
-         res[idxface] =
-             u[P] + 0.5 * Superbee(u[E] - u[P],
-                                   -4. * g[P].dot(rp) - (u[E] - u[P]));
-       } else if (probe[idxface] < -threshold) {
-         res[idxface] =
-             u[E] - 0.5 * Superbee(u[E] - u[P],
-                                   4. * g[E].dot(re) - (u[E] - u[P]));
-       } else {
-         // TODO: Make a CDS proper for non-uniform grids
-         res[idxface] = 0.5 * (u[P] + u[E]);
-       }
-     }
+  res.Reinit(mesh, Scal(0));
+
+  for (IdxFace idxface : mesh.InnerFaces()) {
+    IdxCell P = mesh.GetNeighbourCell(idxface, 0);
+    IdxCell E = mesh.GetNeighbourCell(idxface, 1);
+    Vect rp = mesh.GetVectToCell(idxface, 0); 
+    Vect re = mesh.GetVectToCell(idxface, 1); 
+    const auto& u = fc_u;
+    const auto& g = fc_u_grad;
+    if (probe[idxface] > threshold) {
+      res[idxface] =
+          u[P] + 0.5 * Superbee<Scal>(u[E] - u[P],
+                                -4. * g[P].dot(rp) - (u[E] - u[P]));
+    } else if (probe[idxface] < -threshold) {
+      res[idxface] =
+          u[E] - 0.5 * Superbee<Scal>(u[E] - u[P],
+                                4. * g[E].dot(re) - (u[E] - u[P]));
+    } else {
+      // TODO: Make a CDS proper for non-uniform grids
+      res[idxface] = 0.5 * (u[P] + u[E]);
+    }
   }
 
   // TODO: Move interpolation on boundaries to a function
@@ -615,13 +845,27 @@ InterpolateSuperbee(
       throw std::runtime_error("Unknown boundary condition type");
     }
   }
+}
+
+template <class Mesh>
+geom::FieldFace<typename Mesh::Scal>
+InterpolateSuperbee(
+    const geom::FieldCell<typename Mesh::Scal>& fc_u,
+    const geom::FieldCell<typename Mesh::Vect>& fc_u_grad,
+    const geom::MapFace<std::shared_ptr<ConditionFace>>& mf_cond_u,
+    const geom::FieldFace<typename Mesh::Scal>& probe,
+    const Mesh& mesh, typename Mesh::Scal threshold = 1e-8) {
+  geom::FieldFace<typename Mesh::Scal> res;
+  InterpolateSuperbee(fc_u, fc_u_grad, mf_cond_u, probe, mesh, res,
+                      threshold);
   return res;
 }
 
 template <class T, class Mesh>
-geom::FieldCell<T> Average(const geom::FieldFace<T>& ff_u, const Mesh& mesh) {
+void Average(const geom::FieldFace<T>& ff_u, const Mesh& mesh,
+             geom::FieldCell<T>& res) {
   using Scal = typename Mesh::Scal;
-  geom::FieldCell<T> res(mesh);
+  res.Reinit(mesh);
   for (IdxCell idxcell : mesh.Cells()) {
     T sum(0);
     for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
@@ -630,13 +874,20 @@ geom::FieldCell<T> Average(const geom::FieldFace<T>& ff_u, const Mesh& mesh) {
     }
     res[idxcell] = sum / static_cast<Scal>(mesh.GetNumNeighbourFaces(idxcell));
   }
+}
+
+template <class T, class Mesh>
+geom::FieldCell<T> Average(const geom::FieldFace<T>& ff_u, const Mesh& mesh) {
+  geom::FieldCell<T> res;
+  Average(ff_u, mesh, res);
   return res;
 }
 
+// Result in res, which may be fc_u
 template <class T, class Mesh>
-geom::FieldCell<T>
-GetSmoothField(const geom::FieldCell<T>& fc_u,
-            const Mesh& mesh, size_t repeat = 1) {
+void GetSmoothField(const geom::FieldCell<T>& fc_u,
+                    const Mesh& mesh, geom::FieldCell<T>& res,
+                    size_t repeat = 1) {
   geom::MapFace<std::shared_ptr<ConditionFace>> mf_cond;
 
   for (auto idxface : mesh.Faces()) {
@@ -646,21 +897,34 @@ GetSmoothField(const geom::FieldCell<T>& fc_u,
     }
   }
 
-  geom::FieldCell<T> res = fc_u;
+  if (&res != &fc_u) {
+    res = fc_u;
+  }
 
+  geom::FieldFaceBuffer<T> ff(mesh);
   for (size_t i = 0; i < repeat; ++i) {
-    res = Average(Interpolate(res, mf_cond, mesh), mesh);
+    Interpolate(res, mf_cond, mesh, *ff);
+    Average(*ff, mesh, res);
   }
+}
 
+template <class T, class Mesh>
+geom::FieldCell<T>
+GetSmoothField(const geom::FieldCell<T>& fc_u,
+            const Mesh& mesh, size_t repeat = 1) {
+  geom::FieldCell<T> res;
+  GetSmoothField(fc_u, mesh, res, repeat);
   return res;
 }
 
 template <class Mesh>
-geom::FieldCell<typename Mesh::Vect> Gradient(
-    const geom::FieldFace<typename Mesh::Scal>& ff_u,
-    const Mesh& mesh) {
+void Gradient(const geom::FieldFace<typename Mesh::Scal>& ff_u,
+              const Mesh& mesh,
+              geom::FieldCell<typename Mesh::Vect>& res) {
+  using Scal = typename Mesh::Scal;
   using Vect = typename Mesh::Vect;
-  geom::FieldCell<Vect> res(mesh, Vect::kZero);
+  res.Reinit(mesh, Vect::kZero);
+  const bool axisymmetric = mesh.IsAxisymmetric();
 #pragma omp parallel for
   for (IntIdx rawcell = 0; rawcell < static_cast<IntIdx>(mesh.Cells().size()); ++rawcell) {
     IdxCell idxcell(rawcell);
@@ -671,8 +935,26 @@ geom::FieldCell<typename Mesh::Vect> Gradient(
         sum += mesh.GetOutwardSurface(idxcell, i) * ff_u[idxface];
       }
       res[idxcell] = sum / mesh.GetVolume(idxcell);
+      if (axisymmetric) {
+        // Hoop term: surfaces do not close in the radial direction,
+        // subtract u / r with u estimated by the mean over faces
+        Scal mean = 0.;
+        const size_t nf = mesh.GetNumNeighbourFaces(idxcell);
+        for (size_t i = 0; i < nf; ++i) {
+          mean += ff_u[mesh.GetNeighbourFace(idxcell, i)];
+        }
+        res[idxcell][0] -= mean / nf * mesh.GetHoopFactor(idxcell);
+      }
     }
   }
+}
+
+template <class Mesh>
+geom::FieldCell<typename Mesh::Vect> Gradient(
+    const geom::FieldFace<typename Mesh::Scal>& ff_u,
+    const Mesh& mesh) {
+  geom::FieldCell<typename Mesh::Vect> res;
+  Gradient(ff_u, mesh, res);
   return res;
 }
 
@@ -761,10 +1043,31 @@ class UnsteadyIterativeSolver : public UnsteadySolver {
 //   time_prev -- previous state (n-1)
 enum class Layers { time_curr, time_prev, iter_curr, iter_prev };
 
+// Layers of a field.
+// Only the layers passed to the constructor (all by default) are used,
+// others are never allocated and Get() throws for them.
+// Rotations exchange the storage of layers instead of copying fields.
 template <class T>
 struct LayersData {
   T time_curr, time_prev, iter_curr, iter_prev;
+  LayersData()
+      : LayersData({Layers::time_curr, Layers::time_prev,
+                    Layers::iter_curr, Layers::iter_prev})
+  {}
+  explicit LayersData(std::initializer_list<Layers> layers)
+      : used_{false, false, false, false}
+  {
+    for (auto layer : layers) {
+      used_[static_cast<size_t>(layer)] = true;
+    }
+  }
+  bool IsUsed(Layers layer) const {
+    return used_[static_cast<size_t>(layer)];
+  }
   T& Get(Layers layer) {
+    if (!IsUsed(layer)) {
+      throw(std::runtime_error("LayersData::Get(): Unused layer"));
+    }
     switch (layer) {
       case Layers::time_curr: {
         return time_curr;
@@ -786,6 +1089,30 @@ struct LayersData {
   const T& Get(Layers layer) const {
     return const_cast<const T&>(const_cast<LayersData*>(this)->Get(layer));
   }
+  // Starts a new iteration: iter_prev becomes iter_curr.
+  // Storage of the old iter_prev is reused for iter_curr,
+  // which is stale and must be assigned by the caller.
+  void RotateIter() {
+    if (!IsUsed(Layers::iter_prev)) {
+      return;
+    }
+    if (iter_prev.size() == iter_curr.size()) {
+      std::swap(iter_prev, iter_curr);
+    } else {
+      iter_prev = iter_curr;
+    }
+  }
+  // Finishes a step: time_prev becomes time_curr
+  // and time_curr becomes iter_curr (which is kept).
+  void RotateTime() {
+    if (IsUsed(Layers::time_prev)) {
+      std::swap(time_prev, time_curr);
+    }
+    time_curr = iter_curr;
+  }
+
+ private:
+  bool used_[4];
 };
 
 // Convention: Use Get/Set for fast procedures and Calc for those requiring computation:
@@ -0,0 +1,2 @@
+#include "revision.hpp"
+const std::string kGitRevision = "757241628205caa826bb1fb38bc148d76b700f59";
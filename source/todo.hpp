@@ -16,8 +16,6 @@ TODO Write execution node name to log-file
 
 TODO Limit fields variation on one iteration
 
-TODO Field buffer manager
-
 TODO Reinit Pardiso if you want to change the system structure on the fly
      (e.g. change approximation or boundary conditions type)
 
@@ -11,6 +11,7 @@
 #include "mesh.hpp"
 #include "mesh3d.hpp"
 #include "solver.hpp"
+#include "ghost.hpp"
 
 const int dim = 3;
 using IdxCell = geom::IdxCell;
@@ -102,6 +103,35 @@ class LoopInFaces : public Timer {
   }
 };
 
+// Face accessors resolved statically
+class FaceAreaSum : public Timer {
+  Mesh& m;
+ public:
+  FaceAreaSum(Mesh& m) : Timer("face-area"), m(m) {}
+  void F() override {
+    volatile Scal a = 0;
+    Scal s = a;
+    for (auto i : m.Faces()) {
+      s += m.GetArea(i);
+    }
+    a = s;
+  }
+};
+
+// Same through the generic interface (virtual calls)
+class FaceAreaSumGeneric : public Timer {
+  const geom::MeshGeneric<Scal, dim>& m;
+ public:
+  FaceAreaSumGeneric(Mesh& m) : Timer("face-area-generic"), m(m) {}
+  void F() override {
+    volatile Scal a = 0;
+    Scal s = a;
+    for (auto i : m.Faces()) {
+      s += m.GetArea(i);
+    }
+    a = s;
+  }
+};
 
 // Loop with array
 class LoopArPlain : public Timer {
@@ -187,6 +217,63 @@ class Interp : public Timer {
   }
 };
 
+class InterpTable : public Timer {
+  Mesh& m;
+  geom::FieldCell<Scal> fc;
+  geom::MapFace<std::shared_ptr<solver::ConditionFace>> mfc;
+  solver::ConditionFaceTable<Scal, Mesh> tfc;
+  geom::FieldFace<Scal> ff;
+ public:
+  InterpTable(Mesh& m) : Timer("interp-table"), m(m), fc(m), ff(m) {
+    for (auto i : m.Cells()) {
+      fc[i] = std::sin(i.GetRaw());
+    }
+    auto& bf = m.GetBlockFaces();
+    for (auto i : m.Faces()) {
+      if (bf.GetMIdx(i)[0] == 0 && bf.GetDirection(i) == Dir::i) {
+        mfc[i] = std::make_shared<solver::
+            ConditionFaceDerivativeFixed<Scal>>(0);
+      }
+    }
+    assert(mfc.size() > 0);
+    tfc.Compile(mfc, m);
+  }
+  void F() override {
+    volatile size_t a = 0;
+    solver::Interpolate(fc, tfc, m, ff);
+    a = ff[IdxFace(a)];
+  }
+};
+
+class InterpGhost : public Timer {
+  Mesh& m;
+  geom::FieldCell<Scal> fc;
+  geom::MapFace<std::shared_ptr<solver::ConditionFace>> mfc;
+  solver::FieldCellGhost<Scal, dim> fg;
+  geom::FieldFace<Scal> ff;
+ public:
+  InterpGhost(Mesh& m)
+      : Timer("interp-ghost"), m(m), fc(m), fg(m.GetBlockCells(), 1), ff(m) {
+    for (auto i : m.Cells()) {
+      fc[i] = std::sin(i.GetRaw());
+    }
+    auto& bf = m.GetBlockFaces();
+    for (auto i : m.Faces()) {
+      if (bf.GetMIdx(i)[0] == 0 && bf.GetDirection(i) == Dir::i) {
+        mfc[i] = std::make_shared<solver::
+            ConditionFaceDerivativeFixed<Scal>>(0);
+      }
+    }
+    assert(mfc.size() > 0);
+  }
+  void F() override {
+    volatile size_t a = 0;
+    solver::FillGhost(fg, fc, mfc, m);
+    ff = solver::InterpolateGhost(fg, m);
+    a = ff[IdxFace(a)];
+  }
+};
+
 class Grad : public Timer {
   Mesh& m;
   geom::FieldCell<Vect> fc;
@@ -204,6 +291,139 @@ class Grad : public Timer {
   }
 };
 
+// Gradient of cell field with boundary conditions from table
+class InterpGrad : public Timer {
+  Mesh& m;
+  geom::FieldCell<Scal> fc;
+  geom::MapFace<std::shared_ptr<solver::ConditionFace>> mfc;
+  solver::ConditionFaceTable<Scal, Mesh> tfc;
+  geom::FieldFace<Scal> ff;
+  geom::FieldCell<Vect> fcg;
+ public:
+  InterpGrad(Mesh& m) : Timer("interp-grad"), m(m), fc(m), ff(m), fcg(m) {
+    for (auto i : m.Cells()) {
+      fc[i] = std::sin(i.GetRaw());
+    }
+    for (auto i : m.BoundaryFaces()) {
+      mfc[i] = std::make_shared<solver::ConditionFaceValueFixed<Scal>>(1.);
+    }
+    tfc.Compile(mfc, m);
+  }
+  void F() override {
+    static volatile size_t a = 0;
+    solver::Interpolate(fc, tfc, m, ff);
+    solver::Gradient(ff, m, fcg);
+    a = fcg[IdxCell(a % m.GetNumCells())][0];
+  }
+};
+
+// Same as InterpGrad using ghost cells
+class GradGhost : public Timer {
+  Mesh& m;
+  geom::FieldCell<Scal> fc;
+  geom::MapFace<std::shared_ptr<solver::ConditionFace>> mfc;
+  solver::ConditionFaceTable<Scal, Mesh> tfc;
+  solver::FieldCellGhost<Scal, dim> fg;
+  geom::FieldCell<Vect> fcg;
+ public:
+  GradGhost(Mesh& m)
+      : Timer("grad-ghost"), m(m), fc(m), fg(m.GetBlockCells(), 1), fcg(m) {
+    for (auto i : m.Cells()) {
+      fc[i] = std::sin(i.GetRaw());
+    }
+    for (auto i : m.BoundaryFaces()) {
+      mfc[i] = std::make_shared<solver::ConditionFaceValueFixed<Scal>>(1.);
+    }
+    tfc.Compile(mfc, m);
+  }
+  void F() override {
+    static volatile size_t a = 0;
+    solver::FillGhost(fg, fc, tfc, m);
+    solver::GradientGhost(fg, m, fcg);
+    a = fcg[IdxCell(a % m.GetNumCells())][0];
+  }
+};
+
+// Multi-term update of a vector field in one pass
+class FieldExpr : public Timer {
+  Mesh& m;
+  geom::FieldCell<Vect> fcv;
+  geom::FieldCell<Vect> fcg;
+  geom::FieldCell<Scal> fcr;
+  geom::FieldCell<Scal> fcs;
+ public:
+  FieldExpr(Mesh& m)
+      : Timer("field-expr"), m(m), fcv(m), fcg(m), fcr(m), fcs(m) {
+    for (auto i : m.Cells()) {
+      auto a = i.GetRaw();
+      fcv[i] = Vect(std::sin(a), std::sin(a+1), std::sin(a+2));
+      fcg[i] = Vect(std::cos(a), std::cos(a+1), std::cos(a+2));
+      fcr[i] = std::sin(a+3);
+      fcs[i] = std::sin(a+4);
+    }
+  }
+  void F() override {
+    volatile size_t a = 0;
+    fcv = fcv + fcg * (-1.) + fcg * (fcr * fcs - fcr);
+    a = fcv[IdxCell(a)][0];
+  }
+};
+
+// Volume-averaged density of 4 phases, one field per phase
+class PhaseAver : public Timer {
+  Mesh& m;
+  std::vector<geom::FieldCell<Scal>> vfc_alpha;
+  std::vector<geom::FieldCell<Scal>> vfc_rho;
+  geom::FieldCell<Scal> fc;
+ public:
+  PhaseAver(Mesh& m)
+      : Timer("phase-aver"), m(m), vfc_alpha(4), vfc_rho(4), fc(m) {
+    for (size_t k = 0; k < 4; ++k) {
+      vfc_alpha[k].Reinit(m);
+      vfc_rho[k].Reinit(m);
+      for (auto i : m.Cells()) {
+        auto a = i.GetRaw();
+        vfc_alpha[k][i] = std::sin(a + k);
+        vfc_rho[k][i] = std::cos(a + k);
+      }
+    }
+  }
+  void F() override {
+    volatile size_t a = 0;
+    using T = decltype(vfc_rho[0] * vfc_alpha[0]);
+    std::vector<T> terms;
+    for (size_t k = 0; k < 4; ++k) {
+      terms.push_back(vfc_rho[k] * vfc_alpha[k]);
+    }
+    fc = geom::Sum(terms, m.GetNumCells());
+    a = fc[IdxCell(a)];
+  }
+};
+
+// Same with phases interleaved in each cell
+class PhaseAverMulti : public Timer {
+  Mesh& m;
+  geom::FieldCellMulti<Scal, 4> fcm_alpha;
+  geom::FieldCellMulti<Scal, 4> fcm_rho;
+  geom::FieldCell<Scal> fc;
+ public:
+  PhaseAverMulti(Mesh& m)
+      : Timer("phase-aver-multi"), m(m), fcm_alpha(m, 4), fcm_rho(m, 4) {
+    for (auto i : m.Cells()) {
+      auto a = i.GetRaw();
+      for (size_t k = 0; k < 4; ++k) {
+        fcm_alpha[i][k] = std::sin(a + k);
+        fcm_rho[i][k] = std::cos(a + k);
+      }
+    }
+  }
+  void F() override {
+    volatile size_t a = 0;
+    fc = geom::Dot(fcm_rho, fcm_alpha);
+    a = fc[IdxCell(a)];
+  }
+};
+
 class ExplVisc : public Timer {
   Mesh& m;
   geom::FieldCell<Vect> fcv;
@@ -253,6 +473,51 @@ class ExplVisc : public Timer {
   }
 };
 
+// Same as ExplVisc with temporaries from buffers
+// and velocity components stored separately
+class ExplViscBuf : public Timer {
+  Mesh& m;
+  geom::FieldCellSoA<Vect> fcv;
+  geom::FieldCell<Vect> fcf;
+  geom::FieldFace<Scal> ffmu;
+  geom::MapFace<std::shared_ptr<solver::ConditionFace>> mfc;
+  geom::MapFace<std::shared_ptr<solver::ConditionFace>> mfcf;
+
+ public:
+  ExplViscBuf(Mesh& m)
+      : Timer("explvisc-buf"), m(m), fcv(m), fcf(m), ffmu(m) {
+    for (auto i : m.Cells()) {
+      auto a = i.GetRaw();
+      fcv.Set(i, Vect(std::sin(a), std::sin(a+1), std::sin(a+2)));
+    }
+    for (auto i : m.Faces()) {
+      auto a = i.GetRaw();
+      ffmu[i] = std::sin(a);
+    }
+  }
+  void F() override {
+    using namespace solver;
+    auto& mesh = m;
+    geom::FieldFaceBuffer<Scal> ff(mesh);
+    geom::FieldCellBuffer<Vect> gc(mesh);
+    geom::FieldFaceBuffer<Vect> gf(mesh);
+    for (size_t n = 0; n < dim; ++n) {
+      Interpolate(fcv[n], mfc, mesh, *ff);
+      Gradient(*ff, mesh, *gc);
+      Interpolate(*gc, mfcf, mesh, *gf); // adhoc: zero-der cond
+      for (auto idxcell : mesh.Cells()) {
+        Vect sum = Vect::kZero;
+        for (size_t i = 0; i < mesh.GetNumNeighbourFaces(idxcell); ++i) {
+          IdxFace idxface = mesh.GetNeighbourFace(idxcell, i);
+          sum += (*gf)[idxface] * (ffmu[idxface] *
+              mesh.GetOutwardSurface(idxcell, i)[n]);
+        }
+        fcf[idxcell] += sum / mesh.GetVolume(idxcell);
+      }
+    }
+  }
+};
+
 
 
 
@@ -295,13 +560,23 @@ int main() {
         , new LoopInCells(m)
         , new LoopAllFaces(m)
         , new LoopInFaces(m)
+        , new FaceAreaSum(m)
+        , new FaceAreaSumGeneric(m)
         , new LoopArPlain(m)
         , new LoopArAllCells(m)
         , new LoopMIdxAllCells(m)
         , new LoopMIdxAllFaces(m)
         , new Interp(m)
+        , new InterpTable(m)
+        , new InterpGhost(m)
         , new Grad(m)
+        , new InterpGrad(m)
+        , new GradGhost(m)
+        , new FieldExpr(m)
+        , new PhaseAver(m)
+        , new PhaseAverMulti(m)
         , new ExplVisc(m)
+        , new ExplViscBuf(m)
       };
 
     for (auto& t : tt) {
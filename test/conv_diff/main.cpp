@@ -0,0 +1,88 @@
+#include <iostream>
+#include <cmath>
+#include <memory>
+
+#include "mesh.hpp"
+#include "mesh3d.hpp"
+#include "solver.hpp"
+#include "conv_diff.hpp"
+
+const int dim = 3;
+using IdxCell = geom::IdxCell;
+using IdxFace = geom::IdxFace;
+using Dir = geom::Direction<dim>;
+using Scal = double;
+using Vect = geom::Vect<Scal, dim>;
+using Mesh = geom::geom3d::MeshStructured<Scal>;
+using MIdx = typename Mesh::MIdx;
+
+Mesh GetMesh(MIdx s /*size in cells*/) {
+  geom::Rect<Vect> dom(Vect(0.1, 0.2, 0.1), Vect(1.1, 1.2, 1.3));
+  Mesh m;
+  geom::InitUniformMesh<Mesh>(m, dom, s);
+  return m;
+}
+
+// Solves a convection-diffusion problem with the volume flux
+// converging over iterations, returns the field after two time steps.
+// reuse_limit: iterations to reuse the operator (0 to disable)
+geom::FieldCell<Scal> SolveConvDiff(Mesh& m, size_t reuse_limit) {
+  Vect vel(1., 0.5, 0.25);
+  geom::FieldFace<Scal> ffq(m);
+  geom::FieldFace<Scal> ffd(m, 0.01);
+  geom::FieldCell<Scal> fcr(m, 1.);
+  geom::FieldCell<Scal> fcs(m, 1.);
+  geom::FieldCell<Scal> fc(m, 0.);
+
+  // Given value on the inlet, zero derivative on other boundaries
+  geom::MapFace<std::shared_ptr<solver::ConditionFace>> mfc;
+  auto& bf = m.GetBlockFaces();
+  for (auto i : m.Faces()) {
+    if (m.IsInner(i)) {
+      continue;
+    }
+    if (bf.GetMIdx(i)[0] == 0 && bf.GetDirection(i) == Dir::i) {
+      mfc[i] = std::make_shared<solver::ConditionFaceValueFixed<Scal>>(1.);
+    } else {
+      mfc[i] = std::make_shared<solver::
+          ConditionFaceDerivativeFixed<Scal>>(0.);
+    }
+  }
+  geom::MapCell<std::shared_ptr<solver::ConditionCell>> mcc;
+  solver::LinearSolverFactory lf(
+      std::make_shared<const solver::LuDecompositionFactory>());
+
+  solver::ConvectionDiffusionScalarImplicit<Mesh> s(
+      m, fc, mfc, mcc, 1., &fcr, &ffd, &fcs, &ffq, 0., 0.1, lf,
+      1e-12, 100, true, 0., reuse_limit, 1e-3);
+
+  for (size_t n = 0; n < 2; ++n) {
+    s.StartStep();
+    Scal e = 1e-3;
+    do {
+      for (auto i : m.Faces()) {
+        ffq[i] = vel.dot(m.GetSurface(i)) * (1. + e);
+      }
+      e *= 0.5;
+      s.MakeIteration();
+    } while (!s.IsConverged());
+    s.FinishStep();
+  }
+  return s.GetField();
+}
+
+// Checks that reusing the operator does not change the solution
+int main() {
+  auto m = GetMesh(MIdx(8));
+  auto fc = SolveConvDiff(m, 0);
+  auto fcr = SolveConvDiff(m, 5);
+  Scal diff = 0.;
+  for (auto i : m.Cells()) {
+    diff = std::max(diff, std::abs(fc[i] - fcr[i]));
+  }
+  std::cout << "operator reuse: max difference " << diff << std::endl;
+  if (!(diff < 1e-10)) {
+    std::cerr << "operator reuse: solutions differ" << std::endl;
+    return 1;
+  }
+}